@@ -0,0 +1,574 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file replay_benchmark.cpp
+ * \date October 2026
+ *
+ * Deterministic replay of synthetic data through the ROS-free tracking
+ * core. Serves as benchmark suite and as training workload of the profile
+ * guided build, see README.md. The data is generated from a fixed seed, i.e.
+ * every run processes identical inputs and prints the same checksums.
+ *
+ * If built with DBRT_COUNT_ALLOCATIONS, the steady-state rotary cases are also
+ * an allocation test: the benchmark exits with a non-zero status if the
+ * rotary steps after the warm-up allocate on the heap, either in the rotary
+ * tracker alone or in the rotary path of the fusion tracker.
+ */
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dbot/camera_data.h>
+#include <dbot/virtual_camera_data_provider.h>
+#include <dbrt/builder/rotary_tracker_builder.h>
+#include <dbot/object_model.h>
+#include <dbrt/kinematics_from_urdf.h>
+#include <dbrt/model/surface_point_sensor.h>
+#include <dbrt/robot_state.h>
+#include <dbrt/tracker/fusion_tracker.h>
+#include <dbrt/tracker/rotary_tracker.h>
+#include <dbrt/urdf_object_loader.h>
+#include <dbrt/util/allocation_counter.h>
+#include <dbrt/util/camera_geometry.h>
+#include <dbrt/util/depth_image.h>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct ReplayParameters
+{
+    int joint_count;
+    int joint_obsrv_count;
+    int kinematics_count;
+    int jacobian_count;
+    int image_count;
+    int sensor_count;
+    int image_width;
+    int image_height;
+    int downsampling_factor;
+    unsigned int seed;
+};
+
+/**
+ * \brief Writes a unit cube as ASCII STL, the mesh of all synthetic links
+ */
+void write_cube_mesh(const boost::filesystem::path& filename)
+{
+    // two triangles per face, given by the face normal axis and sign
+    std::ofstream stl(filename.string());
+    stl << "solid cube\n";
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        for (int sign = -1; sign <= 1; sign += 2)
+        {
+            const int u = (axis + 1) % 3;
+            const int v = (axis + 2) % 3;
+            const double corners[4][2] = {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+            const int triangles[2][3] = {{0, 1, 2}, {0, 2, 3}};
+            for (const auto& triangle : triangles)
+            {
+                double normal[3] = {0., 0., 0.};
+                normal[axis] = sign;
+                stl << "facet normal " << normal[0] << " " << normal[1] << " "
+                    << normal[2] << "\n  outer loop\n";
+                for (int k = 0; k < 3; ++k)
+                {
+                    // reverse the winding of the negative faces
+                    const int corner = sign > 0 ? triangle[k] : triangle[2 - k];
+                    double vertex[3];
+                    vertex[axis] = 0.025 * sign;
+                    vertex[u] = 0.025 * corners[corner][0];
+                    vertex[v] = 0.025 * corners[corner][1];
+                    stl << "    vertex " << vertex[0] << " " << vertex[1]
+                        << " " << vertex[2] << "\n";
+                }
+                stl << "  endloop\nendfacet\n";
+            }
+        }
+    }
+    stl << "endsolid cube\n";
+}
+
+/**
+ * \brief Serial chain of revolute joints with alternating axes and a camera
+ *     link in the middle of the chain. Every link carries the cube mesh, i.e.
+ *     the links below the camera move the camera relative to the links above
+ *     it.
+ */
+std::string synthetic_robot_description(int joint_count)
+{
+    std::ostringstream urdf;
+    urdf << "<robot name=\"synthetic_arm\">\n";
+    urdf << "  <link name=\"base\"/>\n";
+    for (int i = 0; i < joint_count; ++i)
+    {
+        std::string parent = i == 0 ? "base" : "link_" + std::to_string(i - 1);
+        urdf << "  <link name=\"link_" << i << "\">\n"
+             << "    <visual><geometry>"
+             << "<mesh filename=\"package://synthetic/cube.stl\"/>"
+             << "</geometry></visual>\n"
+             << "  </link>\n"
+             << "  <joint name=\"joint_" << i << "\" type=\"revolute\">\n"
+             << "    <parent link=\"" << parent << "\"/>\n"
+             << "    <child link=\"link_" << i << "\"/>\n"
+             << "    <origin xyz=\"0 0 0.2\" rpy=\"0 0 0\"/>\n"
+             << "    <axis xyz=\"" << (i % 2) << " " << (1 - i % 2)
+             << " 0\"/>\n"
+             << "    <limit lower=\"-3\" upper=\"3\" effort=\"1\" "
+             << "velocity=\"1\"/>\n"
+             << "  </joint>\n";
+    }
+    urdf << "  <link name=\"camera\"/>\n"
+         << "  <joint name=\"camera_joint\" type=\"fixed\">\n"
+         << "    <parent link=\"link_" << joint_count / 2 << "\"/>\n"
+         << "    <child link=\"camera\"/>\n"
+         << "  </joint>\n"
+         << "</robot>\n";
+    return urdf.str();
+}
+
+/**
+ * \brief Smooth joint trajectory, i.e. independent sinusoids per joint
+ */
+double trajectory(int joint, double t)
+{
+    return 0.5 * std::sin((1. + 0.1 * joint) * t + 0.3 * joint);
+}
+
+/**
+ * \brief Runs the function count times and prints its throughput
+ */
+void run_case(const std::string& name,
+              int count,
+              const std::function<void(int)>& function)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        function(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    std::cout << std::left << std::setw(18) << name << std::right
+              << std::setw(10) << count << std::setw(14) << std::fixed
+              << std::setprecision(1) << count / seconds << " /s"
+              << std::setw(16) << std::setprecision(3) << seconds * 1e6 / count
+              << " us" << std::endl;
+}
+
+int read_arg(int argc, char** argv, const std::string& key, int fallback)
+{
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (key == argv[i]) return std::atoi(argv[i + 1]);
+    }
+    return fallback;
+}
+}
+
+/**
+ * \brief Benchmark entry point
+ */
+int main(int argc, char** argv)
+{
+    ReplayParameters p;
+    p.joint_count = read_arg(argc, argv, "--joints", 20);
+    p.joint_obsrv_count = read_arg(argc, argv, "--joint-obsrvs", 200000);
+    p.kinematics_count = read_arg(argc, argv, "--kinematics", 20000);
+    p.jacobian_count = read_arg(argc, argv, "--jacobians", 2000);
+    p.image_count = read_arg(argc, argv, "--images", 500);
+    p.sensor_count = read_arg(argc, argv, "--sensor-evaluations", 200);
+    p.image_width = read_arg(argc, argv, "--width", 640);
+    p.image_height = read_arg(argc, argv, "--height", 480);
+    p.downsampling_factor = read_arg(argc, argv, "--downsampling", 4);
+    p.seed = read_arg(argc, argv, "--seed", 42);
+
+    std::mt19937 generator(p.seed);
+    std::normal_distribution<double> noise(0., 0.01);
+
+    /* ------------------------------ */
+    /* - Synthetic robot            - */
+    /* ------------------------------ */
+    boost::filesystem::path mesh_path =
+        boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path("dbrt_replay_%%%%%%%%");
+    boost::filesystem::create_directories(mesh_path);
+    write_cube_mesh(mesh_path / "cube.stl");
+
+    auto kinematics = std::make_shared<KinematicsFromURDF>(
+        synthetic_robot_description(p.joint_count),
+        mesh_path.string(),
+        "",
+        "",
+        "camera");
+    const int joint_count = kinematics->num_joints();
+
+    // loading the meshes registers the mesh links
+    auto object_model = std::make_shared<dbot::ObjectModel>(
+        std::make_shared<dbrt::UrdfObjectModelLoader>(kinematics), false);
+    const int link_count = kinematics->num_links();
+
+    dbrt::RobotState<>::kinematics_ = kinematics;
+    dbrt::RobotState<>::kinematics_mutex_ = std::make_shared<std::mutex>();
+
+    typedef dbrt::RotaryTracker Tracker;
+    dbrt::FactorizedTransitionBuilder<Tracker>::Parameters transition;
+    transition.joint_sigmas.assign(joint_count, 1.);
+    transition.bias_sigmas.assign(joint_count, 0.01);
+    transition.bias_factors.assign(joint_count, 1.);
+    transition.joint_count = joint_count;
+
+    dbrt::RotarySensorBuilder<Tracker>::Parameters sensor;
+    sensor.joint_sigmas.assign(joint_count, 0.01);
+    sensor.joint_count = joint_count;
+
+    dbrt::RotaryTrackerBuilder<Tracker> tracker_builder(
+        kinematics,
+        std::make_shared<dbrt::FactorizedTransitionBuilder<Tracker>>(
+            transition),
+        std::make_shared<dbrt::RotarySensorBuilder<Tracker>>(sensor));
+    auto tracker = tracker_builder.build();
+
+    /* ------------------------------ */
+    /* - Synthetic data             - */
+    /* ------------------------------ */
+    // joint measurements at 1 kHz with Gaussian noise
+    std::vector<Tracker::Obsrv> joint_obsrvs(p.joint_obsrv_count,
+                                             Tracker::Obsrv(joint_count));
+    for (int i = 0; i < p.joint_obsrv_count; ++i)
+    {
+        for (int j = 0; j < joint_count; ++j)
+        {
+            joint_obsrvs[i](j) = trajectory(j, i * 1e-3) + noise(generator);
+        }
+    }
+
+    // depth images of a slanted plane with noise and missing pixels
+    std::vector<std::vector<std::uint16_t>> images(
+        std::min(p.image_count, 16),
+        std::vector<std::uint16_t>(p.image_width * p.image_height));
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    for (auto& image : images)
+    {
+        for (int i = 0; i < p.image_width * p.image_height; ++i)
+        {
+            double depth = 1000. + 0.5 * (i % p.image_width) +
+                           100. * noise(generator);
+            image[i] = uniform(generator) < 0.05 ? 0 : std::uint16_t(depth);
+        }
+    }
+
+    std::cout << "dbrt replay benchmark, seed " << p.seed << ", "
+              << joint_count << " joints" << std::endl;
+    std::cout << std::left << std::setw(18) << "case" << std::right
+              << std::setw(10) << "count" << std::setw(17) << "throughput"
+              << std::setw(19) << "time per item" << std::endl;
+
+    /* ------------------------------ */
+    /* - Rotary tracker             - */
+    /* ------------------------------ */
+    Tracker::State initial_state = joint_obsrvs[0];
+    tracker->initialize({initial_state});
+    Tracker::State state = initial_state;
+
+    // steps which may still allocate, e.g. on first use of lazily
+    // initialized storage, as in the rotary thread of the fusion tracker
+    const int warm_up_steps = 100;
+    std::uint64_t warm_allocations = dbrt::thread_allocation_count();
+    run_case("rotary", p.joint_obsrv_count, [&](int i) {
+        if (i == warm_up_steps)
+        {
+            warm_allocations = dbrt::thread_allocation_count();
+        }
+        tracker->track(joint_obsrvs[i], state);
+    });
+    const std::uint64_t rotary_allocations =
+        p.joint_obsrv_count > warm_up_steps
+            ? dbrt::thread_allocation_count() - warm_allocations
+            : 0;
+    double rotary_checksum = state.sum();
+
+    /* ------------------------------ */
+    /* - Fusion rotary path         - */
+    /* ------------------------------ */
+    // the rotary thread of the fusion tracker driven in the calling thread:
+    // observation ingestion, filtering, history snapshots and compression,
+    // and the belief lookup of the visual update. The visual tracker is
+    // never created.
+    dbrt::FusionTracker::BufferParameters buffer_parameters;
+    buffer_parameters.memory_budget = 4 * 1024 * 1024;
+    buffer_parameters.overflow_policy =
+        dbrt::FusionTracker::OverflowPolicy::Compress;
+    buffer_parameters.checkpoint_stride = 10;
+    buffer_parameters.full_rate_window = 0.05;
+
+    dbrt::FusionTracker::LatencyParameters latency_parameters;
+    latency_parameters.budget = -1.;
+    latency_parameters.reduced_sample_fraction = 1.;
+    latency_parameters.max_skipped_frames = 0;
+
+    auto camera_data = std::make_shared<dbot::CameraData>(
+        std::make_shared<dbot::VirtualCameraDataProvider>(
+            p.downsampling_factor, "/XTION"));
+    dbrt::FusionTracker fusion_tracker(
+        camera_data,
+        kinematics,
+        [&]() { return tracker_builder.build(); },
+        []() { return std::shared_ptr<dbrt::DepthTracker>(); },
+        0.,
+        buffer_parameters,
+        latency_parameters);
+    fusion_tracker.initialize({initial_state});
+
+    // joint observations arrive at 1 kHz and are processed in batches. The
+    // belief is looked up 0.1 s in the past, i.e. outside of the full rate
+    // window, which re-filters from the closest checkpoint.
+    const int fusion_batch_size = 10;
+    Tracker::State fusion_state = initial_state;
+    double fusion_checksum = 0.;
+    std::uint64_t fusion_warm_allocations = dbrt::thread_allocation_count();
+    run_case("fusion_rotary",
+             p.joint_obsrv_count / fusion_batch_size,
+             [&](int i) {
+                 if (i == warm_up_steps)
+                 {
+                     fusion_warm_allocations =
+                         dbrt::thread_allocation_count();
+                 }
+                 for (int k = 0; k < fusion_batch_size; ++k)
+                 {
+                     const int index = i * fusion_batch_size + k;
+                     fusion_tracker.joints_obsrv(index * 1e-3,
+                                                 joint_obsrvs[index]);
+                 }
+                 fusion_tracker.process_joints_obsrvs();
+                 const double time = (i + 1) * fusion_batch_size * 1e-3;
+                 if (fusion_tracker.state_at(time - 0.1, fusion_state))
+                 {
+                     fusion_checksum += fusion_state.sum();
+                 }
+             });
+    const std::uint64_t fusion_allocations =
+        p.joint_obsrv_count / fusion_batch_size > warm_up_steps
+            ? dbrt::thread_allocation_count() - fusion_warm_allocations
+            : 0;
+
+    /* ------------------------------ */
+    /* - Forward kinematics         - */
+    /* ------------------------------ */
+    double kinematics_checksum = 0.;
+    Eigen::VectorXd joint_angles(joint_count);
+    run_case("kinematics", p.kinematics_count, [&](int i) {
+        joint_angles = joint_obsrvs[i % p.joint_obsrv_count].cast<double>();
+        kinematics->set_joint_angles(joint_angles);
+        for (int k = 0; k < kinematics->num_links(); ++k)
+        {
+            kinematics_checksum += kinematics->get_link_position(k).sum();
+        }
+    });
+
+    /* ------------------------------ */
+    /* - Link Jacobians             - */
+    /* ------------------------------ */
+    std::vector<Eigen::MatrixXd> jacobians(link_count);
+    double jacobian_checksum = 0.;
+    run_case("jacobians", p.jacobian_count, [&](int i) {
+        joint_angles = joint_obsrvs[i % p.joint_obsrv_count].cast<double>();
+        kinematics->set_joint_angles(joint_angles);
+        kinematics->get_link_jacobians(jacobians);
+        for (const auto& jacobian : jacobians)
+        {
+            jacobian_checksum += jacobian.sum();
+        }
+    });
+
+    // the batch corresponds to the joint states of one visual update, the
+    // time per item is per batch
+    const int batch_size = 32;
+    std::vector<Eigen::VectorXd> batch_states(batch_size);
+    std::vector<std::vector<Eigen::MatrixXd>> batch_jacobians;
+    run_case("jacobians_batch",
+             std::max(p.jacobian_count / batch_size, 1),
+             [&](int i) {
+                 for (int s = 0; s < batch_size; ++s)
+                 {
+                     batch_states[s] =
+                         joint_obsrvs[(i * batch_size + s) %
+                                      p.joint_obsrv_count]
+                             .cast<double>();
+                 }
+                 kinematics->get_link_jacobians(batch_states,
+                                                batch_jacobians);
+             });
+
+    // reference by forward differences, i.e. one forward kinematics pass per
+    // joint. The angular part is taken from the orientation difference.
+    const double delta = 1e-6;
+    std::vector<Eigen::MatrixXd> fd_jacobians(
+        link_count, Eigen::MatrixXd::Zero(6, joint_count));
+    std::vector<Eigen::Vector3d> positions(link_count);
+    std::vector<Eigen::Quaterniond> orientations(link_count);
+    double max_jacobian_error = 0.;
+    run_case("jacobians_fd", p.jacobian_count, [&](int i) {
+        joint_angles = joint_obsrvs[i % p.joint_obsrv_count].cast<double>();
+        kinematics->set_joint_angles(joint_angles);
+        for (int k = 0; k < link_count; ++k)
+        {
+            positions[k] = kinematics->get_link_position(k);
+            orientations[k] = kinematics->get_link_orientation(k);
+        }
+        for (int j = 0; j < joint_count; ++j)
+        {
+            Eigen::VectorXd perturbed = joint_angles;
+            perturbed(j) += delta;
+            kinematics->set_joint_angles(perturbed);
+            for (int k = 0; k < link_count; ++k)
+            {
+                Eigen::AngleAxisd rotation(kinematics->get_link_orientation(k) *
+                                           orientations[k].inverse());
+                fd_jacobians[k].block<3, 1>(0, j) =
+                    (kinematics->get_link_position(k) - positions[k]) / delta;
+                fd_jacobians[k].block<3, 1>(3, j) =
+                    rotation.angle() * rotation.axis() / delta;
+            }
+        }
+
+        // compare against the analytic Jacobians at the same state
+        kinematics->set_joint_angles(joint_angles);
+        kinematics->get_link_jacobians(jacobians);
+        for (int k = 0; k < link_count; ++k)
+        {
+            double error =
+                (jacobians[k] - fd_jacobians[k]).cwiseAbs().maxCoeff();
+            max_jacobian_error = std::max(max_jacobian_error, error);
+        }
+    });
+    std::cout << "max jacobian difference to finite differences: "
+              << std::scientific << std::setprecision(2) << max_jacobian_error
+              << std::fixed << std::endl;
+
+    /* ------------------------------ */
+    /* - Depth image conversion     - */
+    /* ------------------------------ */
+    Eigen::Matrix<fl::Real, Eigen::Dynamic, 1> image_obsrv;
+    double image_checksum = 0.;
+    run_case("depth_image", p.image_count, [&](int i) {
+        dbrt::DepthImageView view;
+        view.timestamp = i * 1. / 30.;
+        view.data = reinterpret_cast<const unsigned char*>(
+            images[i % images.size()].data());
+        view.width = p.image_width;
+        view.height = p.image_height;
+        view.stride = p.image_width * sizeof(std::uint16_t);
+        view.encoding = dbrt::DepthEncoding::UInt16Millimeters;
+        dbrt::depth_image_to_obsrv(view, p.downsampling_factor, image_obsrv);
+        // number of valid pixels, missing pixels are NaN
+        image_checksum += (image_obsrv.array() == image_obsrv.array()).count();
+    });
+
+    /* ------------------------------ */
+    /* - Surface point sensor       - */
+    /* ------------------------------ */
+    // the CPU sensor of the visual tracker scoring one particle set per
+    // image. The particles are spread around the joint measurements and
+    // seen from the camera link of the synthetic arm. The time per item is
+    // per particle set.
+    Eigen::Matrix3d camera_matrix;
+    camera_matrix << 0.8 * p.image_width, 0., 0.5 * (p.image_width - 1), 0.,
+        0.8 * p.image_width, 0.5 * (p.image_height - 1), 0., 0., 1.;
+    dbrt::CameraGeometry camera_geometry =
+        dbrt::CameraGeometry(camera_matrix, p.image_width, p.image_height)
+            .downsampled(p.downsampling_factor);
+
+    dbrt::SurfacePointSensor::Parameters surface_point_parameters;
+    surface_point_parameters.points_per_link = 300;
+    surface_point_parameters.depth_sigma = 0.01;
+    surface_point_parameters.tail_weight = 0.01;
+    surface_point_parameters.occlusion_weight = 0.3;
+    surface_point_parameters.link_cache_size = 0;
+    dbrt::SurfacePointSensor surface_point_sensor(
+        kinematics, object_model, camera_geometry, surface_point_parameters);
+
+    const int particle_count = 100;
+    dbrt::SurfacePointSensor::StateArray particles;
+    dbrt::SurfacePointSensor::IntArray particle_indices(particle_count);
+    particles.resize(particle_count);
+    Tracker::Obsrv particle(joint_count);
+    double sensor_checksum = 0.;
+    run_case("surface_points", p.sensor_count, [&](int i) {
+        dbrt::DepthImageView view;
+        view.timestamp = i * 1. / 30.;
+        view.data = reinterpret_cast<const unsigned char*>(
+            images[i % images.size()].data());
+        view.width = p.image_width;
+        view.height = p.image_height;
+        view.stride = p.image_width * sizeof(std::uint16_t);
+        view.encoding = dbrt::DepthEncoding::UInt16Millimeters;
+        dbrt::depth_image_to_obsrv(view, p.downsampling_factor, image_obsrv);
+        surface_point_sensor.set_observation(image_obsrv);
+
+        // perturbations of about 0.05 rad around the joint measurement
+        const Tracker::Obsrv& joints =
+            joint_obsrvs[(i * 33) % p.joint_obsrv_count];
+        for (int k = 0; k < particle_count; ++k)
+        {
+            for (int j = 0; j < joint_count; ++j)
+            {
+                particle(j) = joints(j) + 5. * noise(generator);
+            }
+            particles(k) = dbrt::RobotState<>(particle);
+            particle_indices(k) = k;
+        }
+        sensor_checksum +=
+            surface_point_sensor.loglikes(particles, particle_indices).sum();
+    });
+
+    // identical inputs must lead to identical outputs
+    std::cout << std::setprecision(9) << "checksums: rotary " << rotary_checksum
+              << ", fusion_rotary " << fusion_checksum << ", kinematics "
+              << kinematics_checksum << ", jacobians " << jacobian_checksum
+              << ", depth_image " << image_checksum << ", surface_points "
+              << sensor_checksum << std::endl;
+
+    boost::filesystem::remove_all(mesh_path);
+
+    if (dbrt::allocation_counting_enabled())
+    {
+        std::cout << "rotary allocations after warm-up: " << rotary_allocations
+                  << ", fusion_rotary allocations after warm-up: "
+                  << fusion_allocations << std::endl;
+        if (rotary_allocations != 0 || fusion_allocations != 0)
+        {
+            std::cerr << "The steady-state rotary path allocated on the heap."
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file pyramid_sensor_builder.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <dbot/builder/rb_sensor_builder.h>
+#include <dbrt/model/pyramid_sensor.h>
+#include <dbrt/robot_state.h>
+#include <dbrt/util/camera_geometry.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Builds a pyramid sensor from level sensors created for the
+ *     downsampled image geometries
+ */
+class PyramidSensorBuilder : public dbot::RbSensorBuilder<RobotState<>>
+{
+public:
+    typedef dbot::RbSensorBuilder<RobotState<>> Base;
+    typedef Base::Model Model;
+    typedef PyramidSensor::Parameters Parameters;
+    typedef std::function<std::shared_ptr<Model>(const CameraGeometry&)>
+        LevelFactory;
+
+public:
+    PyramidSensorBuilder(const std::shared_ptr<dbot::ObjectModel>& object_model,
+                         const std::shared_ptr<dbot::CameraData>& camera_data,
+                         const Base::Parameters& base_parameters,
+                         int level_count,
+                         const Parameters& parameters,
+                         const LevelFactory& create_level)
+        : Base(object_model, camera_data, base_parameters),
+          level_count_(level_count),
+          pyramid_parameters_(parameters),
+          create_level_(create_level)
+    {
+    }
+
+    virtual std::shared_ptr<Model> build() const
+    {
+        const CameraGeometry camera_geometry(*this->camera_data_);
+
+        std::vector<std::shared_ptr<Model>> levels;
+        int factor = 1;
+        for (int level = 0; level < level_count_; ++level)
+        {
+            levels.push_back(
+                create_level_(camera_geometry.downsampled(factor)));
+            factor *= pyramid_parameters_.factor;
+        }
+
+        return std::make_shared<PyramidSensor>(
+            levels, camera_geometry, pyramid_parameters_);
+    }
+
+private:
+    int level_count_;
+    Parameters pyramid_parameters_;
+    LevelFactory create_level_;
+};
+}
@@ -0,0 +1,93 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file sdf_sensor_builder.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <dbot/builder/rb_sensor_builder.h>
+#include <dbrt/kinematics_from_urdf.h>
+#include <dbrt/model/sdf_sensor.h>
+#include <dbrt/model/signed_distance_field.h>
+#include <dbrt/robot_state.h>
+#include <dbrt/util/camera_geometry.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Builds the signed distance field sensor in place of the rendering
+ *     based sensor of the visual tracker
+ */
+class SdfSensorBuilder : public dbot::RbSensorBuilder<RobotState<>>
+{
+public:
+    typedef dbot::RbSensorBuilder<RobotState<>> Base;
+    typedef Base::Model Model;
+
+    struct Parameters
+    {
+        double voxel_size;
+        double truncation;
+        // fields are read from and stored in this file, empty to disable
+        std::string cache_file;
+        SdfSensor::Parameters sensor;
+    };
+
+public:
+    SdfSensorBuilder(const std::shared_ptr<KinematicsFromURDF>& kinematics,
+                     const std::shared_ptr<dbot::ObjectModel>& object_model,
+                     const std::shared_ptr<dbot::CameraData>& camera_data,
+                     const Base::Parameters& base_parameters,
+                     const Parameters& parameters)
+        : Base(object_model, camera_data, base_parameters),
+          kinematics_(kinematics),
+          sdf_parameters_(parameters)
+    {
+    }
+
+    virtual std::shared_ptr<Model> build() const
+    {
+        return build(CameraGeometry(*this->camera_data_));
+    }
+
+    /**
+     * \brief Builds the sensor for the given image geometry. The fields are
+     *     created once and shared by all sensors built.
+     */
+    std::shared_ptr<Model> build(const CameraGeometry& camera_geometry) const
+    {
+        if (fields_.empty())
+        {
+            fields_ =
+                create_signed_distance_fields(*this->object_model_,
+                                              sdf_parameters_.voxel_size,
+                                              sdf_parameters_.truncation,
+                                              sdf_parameters_.cache_file);
+        }
+
+        return std::make_shared<SdfSensor>(
+            kinematics_, camera_geometry, fields_, sdf_parameters_.sensor);
+    }
+
+private:
+    std::shared_ptr<KinematicsFromURDF> kinematics_;
+    Parameters sdf_parameters_;
+    mutable std::vector<SignedDistanceField> fields_;
+};
+}
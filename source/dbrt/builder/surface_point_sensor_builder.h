@@ -0,0 +1,79 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file surface_point_sensor_builder.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <dbot/builder/rb_sensor_builder.h>
+#include <dbrt/kinematics_from_urdf.h>
+#include <dbrt/model/surface_point_sensor.h>
+#include <dbrt/robot_state.h>
+#include <dbrt/util/camera_geometry.h>
+#include <memory>
+
+namespace dbrt
+{
+/**
+ * \brief Builds the surface point sensor in place of the rendering based
+ *     sensor of the visual tracker
+ */
+class SurfacePointSensorBuilder : public dbot::RbSensorBuilder<RobotState<>>
+{
+public:
+    typedef dbot::RbSensorBuilder<RobotState<>> Base;
+    typedef Base::Model Model;
+    typedef SurfacePointSensor::Parameters Parameters;
+
+public:
+    SurfacePointSensorBuilder(
+        const std::shared_ptr<KinematicsFromURDF>& kinematics,
+        const std::shared_ptr<dbot::ObjectModel>& object_model,
+        const std::shared_ptr<dbot::CameraData>& camera_data,
+        const Base::Parameters& base_parameters,
+        const Parameters& parameters,
+        const std::shared_ptr<const KinectLoglikeTable>& kinect_table =
+            nullptr)
+        : Base(object_model, camera_data, base_parameters),
+          kinematics_(kinematics),
+          surface_point_parameters_(parameters),
+          kinect_table_(kinect_table)
+    {
+    }
+
+    virtual std::shared_ptr<Model> build() const
+    {
+        return build(CameraGeometry(*this->camera_data_));
+    }
+
+    /**
+     * \brief Builds the sensor for the given image geometry
+     */
+    std::shared_ptr<Model> build(const CameraGeometry& camera_geometry) const
+    {
+        return std::make_shared<SurfacePointSensor>(kinematics_,
+                                                    this->object_model_,
+                                                    camera_geometry,
+                                                    surface_point_parameters_,
+                                                    kinect_table_);
+    }
+
+private:
+    std::shared_ptr<KinematicsFromURDF> kinematics_;
+    Parameters surface_point_parameters_;
+    std::shared_ptr<const KinectLoglikeTable> kinect_table_;
+};
+}
@@ -33,7 +33,7 @@
 #include <Eigen/Dense>
 #include <dbot/builder/transition_function_builder.h>
 #include <dbrt/builder/exceptions.h>
-#include <fl/model/transition/linear_transition.hpp>
+#include <dbrt/model/diagonal_transition.h>
 #include <fl/util/meta.hpp>
 #include <fl/util/profiling.hpp>
 #include <memory>
@@ -62,7 +62,7 @@ public:
     typedef typename Tracker::Noise Noise;
     typedef typename Tracker::Input Input;
 
-    typedef fl::LinearTransition<State, Noise, Input> Model;
+    typedef DiagonalTransition<State, Noise, Input> Model;
 
     struct Parameters
     {
@@ -79,37 +79,19 @@ public:
             throw InvalidNumberOfJointSigmasException();
         }
 
-        int total_state_dim = param_.joint_count;
-        int total_noise_dim = total_state_dim;
-
-        auto model =
-            std::make_shared<Model>(total_state_dim, total_noise_dim, 1);
-
-        auto A = model->create_dynamics_matrix();
-        auto B = model->create_noise_matrix();
-        auto C = model->create_input_matrix();
-
-        auto part_A = Eigen::Matrix<fl::Real, 1, 1>();
-        auto part_B = Eigen::Matrix<fl::Real, 1, 1>();
-
-        A.setZero();
-        B.setZero();
-        C.setZero();
-
-        part_A.setIdentity();
-
-        part_B.setIdentity();
-        part_B *= param_.joint_sigma;
+        // joints perform independent random walks, hence both dynamics and
+        // noise matrices are diagonal
+        auto model = std::make_shared<Model>(param_.joint_count, 1);
 
+        typename Model::DiagonalVector noise_diagonal(param_.joint_count);
         for (int i = 0; i < param_.joint_count; ++i)
         {
-            A.block(i, i, 1, 1) = part_A;
-            B(i, i) = param_.joint_sigmas[i];
+            noise_diagonal(i) = param_.joint_sigmas[i];
         }
 
-        model->dynamics_matrix(A);
-        model->noise_matrix(B);
-        model->input_matrix(C);
+        model->dynamics_diagonal(
+            Model::DiagonalVector::Ones(param_.joint_count));
+        model->noise_diagonal(noise_diagonal);
 
         return model;
     }
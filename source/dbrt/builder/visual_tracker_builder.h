@@ -69,6 +69,9 @@ public:
         double moving_average_update_rate;
         double max_kl_divergence;
         std::vector<std::vector<int>> sampling_blocks;
+        // joints which are not part of any sampling block and hence keep
+        // the value they have been initialized with
+        std::vector<int> fixed_joints;
     };
 
 public:
@@ -109,7 +112,8 @@ public:
         const std::shared_ptr<dbot::ObjectModel>& object_model,
         double max_kl_divergence)
     {
-        if (count_sampling_block_indices(params_.sampling_blocks) !=
+        if (count_sampling_block_indices(params_.sampling_blocks) +
+                params_.fixed_joints.size() !=
             urdf_kinematics_->num_joints())
         {
             throw InvalidNumberOfSamplingBlocksException();
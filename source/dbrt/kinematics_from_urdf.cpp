@@ -19,6 +19,7 @@
  * \author Manuel Wuthrich (manuel.wuthrich@gmail.com)
  */
 
+#include <algorithm>
 #include <boost/random/normal_distribution.hpp>
 #include <dbrt/kinematics_from_urdf.h>
 #include <fl/util/profiling.hpp>
@@ -34,7 +35,9 @@ KinematicsFromURDF::KinematicsFromURDF(
       rendering_root_left_(rendering_root_left),
       rendering_root_right_(rendering_root_right),
       cam_frame_name_(camera_frame_id),
-      use_camera_offset_(use_camera_offset)
+      use_camera_offset_(use_camera_offset),
+      camera_node_(-1),
+      tree_frames_valid_(false)
 {
     camera_offset_.setZero();
 
@@ -86,6 +89,7 @@ KinematicsFromURDF::KinematicsFromURDF(
 
     // initialise kinematic tree solver
     tree_solver_ = new KDL::TreeFkSolverPos_recursive(kin_tree_);
+    build_tree_nodes();
 }
 
 void KinematicsFromURDF::rename_camera_frame(const std::string& camera_frame,
@@ -261,6 +265,7 @@ void KinematicsFromURDF::set_joint_angles(const Eigen::VectorXd& joint_state)
         jnt_array_.data = joint_state.topRows(kin_tree_.getNrOfJoints());
         // Given the new joint angles, compute all link transforms in one go
         compute_transforms();
+        tree_frames_valid_ = false;
     }
 }
 
@@ -342,58 +347,257 @@ dbot::PoseVector KinematicsFromURDF::get_link_pose(int index)
     return pose_vector;
 }
 
-Eigen::VectorXd KinematicsFromURDF::sensor_msg_to_eigen(
-    const sensor_msgs::JointState& sensor_msg)
+KDL::Frame KinematicsFromURDF::get_frame_pose(const std::string& name)
 {
-    sensor_msgs::JointState joint_state = sensor_msg;
+    KDL::Frame frame;
+    if (tree_solver_->JntToCart(jnt_array_, frame, name) < 0)
+        ROS_ERROR("TreeSolver returned an error for link %s", name.c_str());
 
-    if (use_camera_offset_)
+    return frame;
+}
+
+void KinematicsFromURDF::build_tree_nodes()
+{
+    tree_nodes_.clear();
+
+    // depth-first traversal, hence parents are added before their children
+    std::vector<std::pair<KDL::SegmentMap::const_iterator, int>> stack = {
+        {kin_tree_.getRootSegment(), -1}};
+    while (!stack.empty())
     {
-        joint_state.name.push_back(cam_frame_name_ + "_X_JOINT");
-        joint_state.name.push_back(cam_frame_name_ + "_Y_JOINT");
-        joint_state.name.push_back(cam_frame_name_ + "_Z_JOINT");
-        joint_state.name.push_back(cam_frame_name_ + "_ROLL_JOINT");
-        joint_state.name.push_back(cam_frame_name_ + "_PITCH_JOINT");
-        joint_state.name.push_back(cam_frame_name_ + "_YAW_JOINT");
-
-        joint_state.position.push_back(0);
-        joint_state.position.push_back(0);
-        joint_state.position.push_back(0);
-        joint_state.position.push_back(0);
-        joint_state.position.push_back(0);
-        joint_state.position.push_back(0);
+        auto entry = stack.back();
+        stack.pop_back();
+
+        const KDL::Segment& segment = entry.first->second.segment;
+        const KDL::Joint::JointType type = segment.getJoint().getType();
+
+        TreeNode node;
+        node.segment = segment;
+        node.parent = entry.second;
+        node.joint_index =
+            type == KDL::Joint::None ? -1 : int(entry.first->second.q_nr);
+        node.prismatic = type == KDL::Joint::TransAxis ||
+                         type == KDL::Joint::TransX ||
+                         type == KDL::Joint::TransY ||
+                         type == KDL::Joint::TransZ;
+        tree_nodes_.push_back(node);
+
+        const int index = tree_nodes_.size() - 1;
+        if (segment.getName() == cam_frame_name_) camera_node_ = index;
+
+        for (const auto& child : entry.first->second.children)
+        {
+            stack.push_back({child, index});
+        }
+    }
+
+    if (camera_node_ < 0)
+    {
+        ROS_ERROR("Camera frame %s not found in kinematic tree",
+                  cam_frame_name_.c_str());
     }
+}
+
+void KinematicsFromURDF::update_relative_joints()
+{
+    // mesh links are registered when loading the part meshes
+    if (link_nodes_.size() == mesh_names_.size()) return;
 
-    check_size(joint_state.position.size());
+    auto joint_nodes = [this](int node) {
+        std::vector<int> joint_nodes;
+        for (; node >= 0; node = tree_nodes_[node].parent)
+        {
+            if (tree_nodes_[node].joint_index >= 0) joint_nodes.push_back(node);
+        }
+        return joint_nodes;
+    };
+    auto contains = [](const std::vector<int>& nodes, int node) {
+        return std::find(nodes.begin(), nodes.end(), node) != nodes.end();
+    };
 
-    Eigen::VectorXd eigen(joint_state.position.size());
+    const std::vector<int> camera_joint_nodes = joint_nodes(camera_node_);
 
-    for (size_t i = 0; i < joint_state.position.size(); i++)
+    link_nodes_.resize(mesh_names_.size());
+    relative_joints_.resize(mesh_names_.size());
+    for (size_t i = 0; i < mesh_names_.size(); ++i)
     {
-        int joint_index = name_to_index(joint_state.name[i]);
+        link_nodes_[i] = -1;
+        for (size_t n = 0; n < tree_nodes_.size(); ++n)
+        {
+            if (tree_nodes_[n].segment.getName() == mesh_names_[i])
+            {
+                link_nodes_[i] = n;
+                break;
+            }
+        }
 
-        if (joint_index >= 0)
+        // joints shared by the link and the camera do not change their
+        // relative pose
+        const std::vector<int> link_joint_nodes = joint_nodes(link_nodes_[i]);
+        relative_joints_[i].clear();
+        for (int node : link_joint_nodes)
         {
-            eigen(joint_index) = joint_state.position[i];
+            if (!contains(camera_joint_nodes, node))
+            {
+                relative_joints_[i].push_back({node, 1.});
+            }
         }
-        else
+        for (int node : camera_joint_nodes)
+        {
+            if (!contains(link_joint_nodes, node))
+            {
+                relative_joints_[i].push_back({node, -1.});
+            }
+        }
+    }
+}
+
+void KinematicsFromURDF::compute_tree_frames(const Eigen::VectorXd& joint_state,
+                                             TreeFrames& tree_frames) const
+{
+    tree_frames.frames.resize(tree_nodes_.size());
+    tree_frames.axes.resize(tree_nodes_.size());
+    tree_frames.origins.resize(tree_nodes_.size());
+
+    for (size_t i = 0; i < tree_nodes_.size(); ++i)
+    {
+        const TreeNode& node = tree_nodes_[i];
+        const KDL::Frame parent = node.parent < 0
+                                      ? KDL::Frame::Identity()
+                                      : tree_frames.frames[node.parent];
+
+        if (node.joint_index < 0)
+        {
+            tree_frames.frames[i] = parent * node.segment.pose(0.);
+            continue;
+        }
+
+        const KDL::Joint& joint = node.segment.getJoint();
+        tree_frames.frames[i] =
+            parent * node.segment.pose(joint_state(node.joint_index));
+        tree_frames.axes[i] = parent.M * joint.JointAxis();
+        tree_frames.origins[i] = parent * joint.JointOrigin();
+    }
+}
+
+void KinematicsFromURDF::compute_link_jacobian(const TreeFrames& tree_frames,
+                                               int index,
+                                               Eigen::MatrixXd& jacobian) const
+{
+    const int joint_count = kin_tree_.getNrOfJoints();
+    if (jacobian.rows() != 6 || jacobian.cols() != joint_count)
+    {
+        jacobian.resize(6, joint_count);
+    }
+    jacobian.setZero();
+
+    const KDL::Rotation base_to_camera =
+        tree_frames.frames[camera_node_].M.Inverse();
+    const KDL::Vector& link_origin = tree_frames.frames[link_nodes_[index]].p;
+
+    for (const RelativeJoint& relative_joint : relative_joints_[index])
+    {
+        const TreeNode& node = tree_nodes_[relative_joint.node];
+        const KDL::Vector& axis = tree_frames.axes[relative_joint.node];
+
+        // KDL::Vector * KDL::Vector is the cross product
+        KDL::Vector linear =
+            node.prismatic
+                ? base_to_camera * axis
+                : base_to_camera *
+                      (axis * (link_origin -
+                               tree_frames.origins[relative_joint.node]));
+
+        for (int i = 0; i < 3; ++i)
+        {
+            jacobian(i, node.joint_index) = relative_joint.sign * linear(i);
+        }
+        if (node.prismatic) continue;
+
+        KDL::Vector angular = base_to_camera * axis;
+        for (int i = 0; i < 3; ++i)
         {
-            ROS_ERROR("i: %d, No joint index for %s",
-                      int(i),
-                      joint_state.name[i].c_str());
+            jacobian(3 + i, node.joint_index) =
+                relative_joint.sign * angular(i);
         }
     }
+}
+
+void KinematicsFromURDF::get_link_jacobian(int index,
+                                           Eigen::MatrixXd& jacobian)
+{
+    update_relative_joints();
+    if (!tree_frames_valid_)
+    {
+        compute_tree_frames(jnt_array_.data, tree_frames_);
+        tree_frames_valid_ = true;
+    }
 
-    return eigen;
+    compute_link_jacobian(tree_frames_, index, jacobian);
+}
+
+void KinematicsFromURDF::get_link_jacobians(
+    std::vector<Eigen::MatrixXd>& jacobians)
+{
+    jacobians.resize(num_links());
+    for (int i = 0; i < num_links(); ++i)
+    {
+        get_link_jacobian(i, jacobians[i]);
+    }
+}
+
+void KinematicsFromURDF::get_link_jacobians(
+    const std::vector<Eigen::VectorXd>& joint_states,
+    std::vector<std::vector<Eigen::MatrixXd>>& jacobians)
+{
+    update_relative_joints();
+
+    jacobians.resize(joint_states.size());
+    for (size_t s = 0; s < joint_states.size(); ++s)
+    {
+        check_size(joint_states[s].size());
+        compute_tree_frames(joint_states[s], batch_tree_frames_);
+
+        jacobians[s].resize(num_links());
+        for (int i = 0; i < num_links(); ++i)
+        {
+            compute_link_jacobian(batch_tree_frames_, i, jacobians[s][i]);
+        }
+    }
+}
+
+std::vector<int> KinematicsFromURDF::get_link_joint_indices(int index)
+{
+    update_relative_joints();
+
+    std::vector<int> indices;
+    for (const RelativeJoint& relative_joint : relative_joints_[index])
+    {
+        indices.push_back(tree_nodes_[relative_joint.node].joint_index);
+    }
+    std::sort(indices.begin(), indices.end());
+
+    return indices;
 }
 
 std::vector<int> KinematicsFromURDF::get_joint_order(
-    const sensor_msgs::JointState& state)
+    const std::vector<std::string>& joint_names)
 {
-    std::vector<int> order(state.name.size());
-    for (int i = 0; i < state.name.size(); ++i)
+    check_size(joint_names.size() + camera_offset_joint_indices().size());
+
+    std::vector<int> order(joint_names.size(), -1);
+    for (int i = 0; i < joint_names.size(); ++i)
     {
-        order[i] = name_to_index(state.name[i]);
+        auto joint = std::find(
+            joint_map_.begin(), joint_map_.end(), joint_names[i]);
+        if (joint == joint_map_.end())
+        {
+            ROS_ERROR(
+                "i: %d, No joint index for %s", i, joint_names[i].c_str());
+            continue;
+        }
+
+        order[i] = joint - joint_map_.begin();
     }
 
     return order;
@@ -416,6 +620,19 @@ int KinematicsFromURDF::name_to_index(const std::string& name)
     return -1;
 }
 
+std::vector<int> KinematicsFromURDF::camera_offset_joint_indices()
+{
+    std::vector<int> indices;
+    if (!use_camera_offset_) return indices;
+
+    for (auto dof : {"_X", "_Y", "_Z", "_PITCH", "_YAW", "_ROLL"})
+    {
+        indices.push_back(name_to_index(cam_frame_name_ + dof + "_JOINT"));
+    }
+
+    return indices;
+}
+
 std::string KinematicsFromURDF::get_link_name(int idx)
 {
     return mesh_names_[idx];
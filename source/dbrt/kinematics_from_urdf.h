@@ -31,7 +31,6 @@
 #include <kdl_parser/kdl_parser.hpp>
 #include <list>
 #include <ros/ros.h>
-#include <sensor_msgs/JointState.h>
 #include <urdf/model.h>
 #include <vector>
 
@@ -55,7 +54,52 @@ public:
     Eigen::Quaternion<double> get_link_orientation(int index);
     dbot::PoseVector get_link_pose(int index);
 
-    std::vector<int> get_joint_order(const sensor_msgs::JointState& state);
+    /**
+     * \brief Pose of the frame with the given name relative to the root
+     *     frame at the current joint angles
+     */
+    KDL::Frame get_frame_pose(const std::string& name);
+
+    /**
+     * \brief Computes the geometric Jacobian of the mesh link with the given
+     *     index with respect to all joints at the current joint angles. The
+     *     first three rows are the linear velocity of the link origin, the
+     *     last three rows the angular velocity, both in the camera frame.
+     *     Columns of joints which do not move the link relative to the
+     *     camera are zero, see get_link_joint_indices().
+     */
+    void get_link_jacobian(int index, Eigen::MatrixXd& jacobian);
+
+    /**
+     * \brief Computes the Jacobians of all mesh links in one pass over the
+     *     tree at the current joint angles
+     */
+    void get_link_jacobians(std::vector<Eigen::MatrixXd>& jacobians);
+
+    /**
+     * \brief Batched variant computing the Jacobians of all mesh links for
+     *     each of the given joint states, i.e. jacobians[s][i] is the
+     *     Jacobian of link i at joint_states[s]. Does not change the current
+     *     joint angles.
+     */
+    void get_link_jacobians(
+        const std::vector<Eigen::VectorXd>& joint_states,
+        std::vector<std::vector<Eigen::MatrixXd>>& jacobians);
+
+    /**
+     * \brief Returns the state indices of the joints which move the given
+     *     mesh link relative to the camera, i.e. the non-zero Jacobian
+     *     columns
+     */
+    std::vector<int> get_link_joint_indices(int index);
+
+    /**
+     * \brief Returns the state index of each of the given joints. All joints
+     *     except for the injected camera offset joints must be given. Joints
+     *     unknown to the model are reported and get the index -1.
+     */
+    std::vector<int> get_joint_order(
+        const std::vector<std::string>& joint_names);
     void get_part_meshes(
         std::vector<boost::shared_ptr<PartMeshModel>>& part_meshes);
     KDL::Tree get_tree();
@@ -67,7 +111,6 @@ public:
     std::string get_root_frame_id();
 
     /// convenience ************************************************************
-    Eigen::VectorXd sensor_msg_to_eigen(const sensor_msgs::JointState& angles);
     void print_joints();
     void print_links();
 
@@ -76,14 +119,62 @@ public:
 
     const std::string& camera_frame_id() const { return cam_frame_name_; }
 
+    /**
+     * \brief Returns the state indices of the six injected camera offset
+     *     joints, or an empty vector if the camera offset is not used
+     */
+    std::vector<int> camera_offset_joint_indices();
+
 private:
     void rename_camera_frame(const std::string& camera_frame,
                              urdf::Model& urdf);
     void inject_offset_joints_and_links(const std::string& camera_frame,
                                         urdf::Model& urdf);
 
+    /**
+     * \brief Segment of the kinematic tree. Parents precede their children.
+     */
+    struct TreeNode
+    {
+        KDL::Segment segment;
+        // index of the parent node, -1 for the root
+        int parent;
+        // index of the joint within the state, -1 for fixed joints
+        int joint_index;
+        bool prismatic;
+    };
+
+    /**
+     * \brief Joint moving a link relative to the camera. The sign is
+     *     negative for joints which move the camera only.
+     */
+    struct RelativeJoint
+    {
+        int node;
+        double sign;
+    };
+
+    /**
+     * \brief Segment frames, joint axes and joint origins in the base frame
+     *     for one joint state
+     */
+    struct TreeFrames
+    {
+        std::vector<KDL::Frame> frames;
+        std::vector<KDL::Vector> axes;
+        std::vector<KDL::Vector> origins;
+    };
+
     void check_size(int size);
 
+    void build_tree_nodes();
+    void update_relative_joints();
+    void compute_tree_frames(const Eigen::VectorXd& joint_state,
+                             TreeFrames& tree_frames) const;
+    void compute_link_jacobian(const TreeFrames& tree_frames,
+                               int index,
+                               Eigen::MatrixXd& jacobian) const;
+
     void compute_transforms();
 
     // std::string tf_correction_root_;
@@ -107,6 +198,18 @@ private:
     // Forward kinematics solver
     KDL::TreeFkSolverPos_recursive* tree_solver_;
 
+    // kinematic tree in depth-first order for the Jacobian computation
+    std::vector<TreeNode> tree_nodes_;
+    int camera_node_;
+    // tree node of each mesh link and the joints moving it relative to the
+    // camera
+    std::vector<int> link_nodes_;
+    std::vector<std::vector<RelativeJoint>> relative_joints_;
+    // tree frames at the current joint angles, computed on demand
+    TreeFrames tree_frames_;
+    bool tree_frames_valid_;
+    TreeFrames batch_tree_frames_;
+
     // KDL copy of the joint state
     KDL::JntArray jnt_array_;
     // Contains Camera pose relative to base
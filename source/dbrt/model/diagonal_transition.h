@@ -0,0 +1,107 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file diagonal_transition.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <fl/model/transition/interface/transition_function.hpp>
+#include <fl/util/types.hpp>
+
+namespace dbrt
+{
+/**
+ * \brief Linear transition function with diagonal dynamics and diagonal noise
+ *     matrix, i.e.
+ *
+ *     x_{t+1} = a .* x_t + b .* v_t
+ *
+ * where a and b are the diagonals of the dynamics and noise matrix. This is
+ * the special case of fl::LinearTransition for independent random walks of
+ * the joints. Sampling a state costs O(n) instead of the O(n^2) dense matrix
+ * vector products. The input is ignored.
+ */
+template <typename State, typename Noise, typename Input>
+class DiagonalTransition : public fl::TransitionFunction<State, Noise, Input>
+{
+public:
+    typedef Eigen::Matrix<fl::Real, Eigen::Dynamic, 1> DiagonalVector;
+
+public:
+    /**
+     * \brief Creates an identity transition without noise
+     *
+     * \param state_dim     State dimension which equals the noise dimension
+     * \param input_dim     Input dimension which is ignored by the model
+     */
+    DiagonalTransition(int state_dim, int input_dim)
+        : dynamics_diagonal_(DiagonalVector::Ones(state_dim)),
+          noise_diagonal_(DiagonalVector::Zero(state_dim)),
+          input_dimension_(input_dim)
+    {
+    }
+
+    virtual ~DiagonalTransition() noexcept {}
+
+    virtual State state(const State& prev_state,
+                        const Noise& noise,
+                        const Input& input) const
+    {
+        State next_state = prev_state;
+        next_state.array() = dynamics_diagonal_.array() * prev_state.array() +
+                             noise_diagonal_.array() * noise.array();
+        return next_state;
+    }
+
+    virtual int state_dimension() const { return dynamics_diagonal_.size(); }
+    virtual int noise_dimension() const { return noise_diagonal_.size(); }
+    virtual int input_dimension() const { return input_dimension_; }
+
+    const DiagonalVector& dynamics_diagonal() const
+    {
+        return dynamics_diagonal_;
+    }
+
+    const DiagonalVector& noise_diagonal() const { return noise_diagonal_; }
+
+    /**
+     * \brief Sets the diagonal of the dynamics matrix. Does not reallocate
+     *     if the dimension is unchanged.
+     */
+    template <typename Vector>
+    void dynamics_diagonal(const Eigen::MatrixBase<Vector>& diagonal)
+    {
+        dynamics_diagonal_ = diagonal;
+    }
+
+    /**
+     * \brief Sets the diagonal of the noise matrix, i.e. the standard
+     *     deviations of the joint random walks. Does not reallocate if the
+     *     dimension is unchanged.
+     */
+    template <typename Vector>
+    void noise_diagonal(const Eigen::MatrixBase<Vector>& diagonal)
+    {
+        noise_diagonal_ = diagonal;
+    }
+
+protected:
+    DiagonalVector dynamics_diagonal_;
+    DiagonalVector noise_diagonal_;
+    int input_dimension_;
+};
+}
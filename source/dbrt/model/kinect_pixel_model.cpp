@@ -0,0 +1,104 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file kinect_pixel_model.cpp
+ * \date October 2026
+ */
+
+#include <algorithm>
+#include <dbrt/model/kinect_pixel_model.h>
+
+namespace dbrt
+{
+KinectPixelModel::KinectPixelModel(const Parameters& parameters)
+    : parameters_(parameters)
+{
+}
+
+double KinectPixelModel::loglike(double predicted, double observed) const
+{
+    const Parameters& p = parameters_;
+    const double tail = p.tail_weight / p.max_depth;
+
+    const double s = sigma(observed);
+    const double residual = observed - predicted;
+    const double visible =
+        tail + (1. - p.tail_weight) *
+                   std::exp(-0.5 * residual * residual / (s * s)) /
+                   (std::sqrt(2. * M_PI) * s);
+
+    // occluders are in front of the predicted surface
+    double occluded = tail;
+    if (observed <= predicted)
+    {
+        occluded += (1. - p.tail_weight) * p.exponential_rate *
+                    std::exp(-p.exponential_rate * observed) /
+                    (1. - std::exp(-p.exponential_rate * predicted));
+    }
+
+    return std::log((1. - p.occlusion_probability) * visible +
+                    p.occlusion_probability * occluded);
+}
+
+KinectLoglikeTable::KinectLoglikeTable(const KinectPixelModel& model,
+                                       const Parameters& parameters)
+    : model_(model),
+      min_depth_(parameters.min_depth),
+      inverse_depth_step_(1. / parameters.depth_step),
+      residual_range_(parameters.residual_range),
+      inverse_residual_step_(1. / parameters.residual_step),
+      model_sigma_(model.parameters().model_sigma),
+      sigma_factor_(model.parameters().sigma_factor),
+      max_error_(0.)
+{
+    const double depth_range = parameters.max_depth - parameters.min_depth;
+    rows_ = int(std::ceil(depth_range / parameters.depth_step)) + 1;
+    columns_ = int(std::ceil(2. * parameters.residual_range /
+                             parameters.residual_step)) +
+               1;
+
+    auto exact = [&](double row, double column) {
+        const double predicted = min_depth_ + row * parameters.depth_step;
+        const double residual =
+            (column * parameters.residual_step - residual_range_) *
+            sigma(predicted);
+        return model_.loglike(predicted, predicted + residual);
+    };
+
+    values_.resize(rows_ * columns_);
+    for (int r = 0; r < rows_; ++r)
+    {
+        for (int c = 0; c < columns_; ++c)
+        {
+            values_[r * columns_ + c] = exact(r, c);
+        }
+    }
+
+    for (int r = 0; r + 1 < rows_; ++r)
+    {
+        for (int c = 0; c + 1 < columns_; ++c)
+        {
+            const double predicted =
+                min_depth_ + (r + 0.5) * parameters.depth_step;
+            const double residual =
+                ((c + 0.5) * parameters.residual_step - residual_range_) *
+                sigma(predicted);
+            const double error = std::fabs(
+                exact(r + 0.5, c + 0.5) -
+                loglike(predicted, predicted + residual));
+            max_error_ = std::max(max_error_, error);
+        }
+    }
+}
+}
@@ -0,0 +1,160 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file kinect_pixel_model.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Per pixel depth likelihood of the Kinect sensor model.
+ *
+ * A visible pixel is a Gaussian around the predicted depth with a standard
+ * deviation growing quadratically in the observed depth. An occluded pixel
+ * follows an exponential distribution truncated at the predicted depth. Both
+ * are mixed with a uniform tail over the depth range.
+ */
+class KinectPixelModel
+{
+public:
+    struct Parameters
+    {
+        double tail_weight;
+        double model_sigma;
+        double sigma_factor;
+        double occlusion_probability;
+        double exponential_rate;
+        double max_depth;
+    };
+
+public:
+    explicit KinectPixelModel(const Parameters& parameters);
+
+    /**
+     * \brief Exact log-likelihood of the observed depth given the predicted
+     *     depth, both in meters
+     */
+    double loglike(double predicted, double observed) const;
+
+    /**
+     * \brief Standard deviation of the visible component at the given depth
+     */
+    double sigma(double depth) const
+    {
+        return parameters_.model_sigma +
+               parameters_.sigma_factor * depth * depth;
+    }
+
+    const Parameters& parameters() const { return parameters_; }
+
+private:
+    Parameters parameters_;
+};
+
+/**
+ * \brief Kinect pixel log-likelihood tabulated over the predicted depth and
+ *     the residual, i.e. observed minus predicted depth.
+ *
+ * The residual axis is scaled by the standard deviation at the predicted
+ * depth, such that the Gaussian is resolved equally well at all depths.
+ * Lookups interpolate bilinearly. Pairs outside the table are evaluated
+ * exactly. The largest deviation from the exact model, measured at the cell
+ * centers where bilinear interpolation errs most, is available as max_error().
+ */
+class KinectLoglikeTable
+{
+public:
+    struct Parameters
+    {
+        double min_depth;
+        double max_depth;
+        // row spacing in meters
+        double depth_step;
+        // columns cover +-residual_range standard deviations
+        double residual_range;
+        // column spacing in standard deviations
+        double residual_step;
+    };
+
+public:
+    KinectLoglikeTable(const KinectPixelModel& model,
+                       const Parameters& parameters);
+
+    float loglike(float predicted, float observed) const
+    {
+        const float row = (predicted - min_depth_) * inverse_depth_step_;
+        const float column =
+            ((observed - predicted) / sigma(predicted) + residual_range_) *
+            inverse_residual_step_;
+        if (!(row >= 0.f && row < rows_ - 1 && column >= 0.f &&
+              column < columns_ - 1))
+        {
+            return model_.loglike(predicted, observed);
+        }
+
+        const int r = int(row);
+        const int c = int(column);
+        const float fr = row - r;
+        const float fc = column - c;
+        const float* v = &values_[r * columns_ + c];
+
+        const float top = v[0] + fc * (v[1] - v[0]);
+        const float bottom = v[columns_] + fc * (v[columns_ + 1] - v[columns_]);
+        return top + fr * (bottom - top);
+    }
+
+    /**
+     * \brief Log-likelihood of an observation far in front of the predicted
+     *     depth, i.e. of a pixel which is most likely occluded
+     */
+    float occluded_loglike(float predicted) const
+    {
+        return loglike(predicted,
+                       predicted - residual_range_ * sigma(predicted));
+    }
+
+    /**
+     * \brief Maximum absolute log-likelihood error within the table
+     */
+    double max_error() const { return max_error_; }
+
+    int size() const { return values_.size(); }
+
+private:
+    float sigma(float depth) const
+    {
+        return model_sigma_ + sigma_factor_ * depth * depth;
+    }
+
+private:
+    KinectPixelModel model_;
+    float min_depth_;
+    float inverse_depth_step_;
+    float residual_range_;
+    float inverse_residual_step_;
+    float model_sigma_;
+    float sigma_factor_;
+    int rows_;
+    int columns_;
+    // row major, one row per predicted depth
+    std::vector<float> values_;
+    double max_error_;
+};
+}
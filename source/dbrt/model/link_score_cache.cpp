@@ -0,0 +1,118 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file link_score_cache.cpp
+ * \date October 2026
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <dbrt/model/link_score_cache.h>
+
+namespace dbrt
+{
+LinkScoreCache::LinkScoreCache(int capacity)
+    : generation_(1),
+      size_(0),
+      generations_(capacity, 0),
+      hashes_(capacity, 0),
+      keys_(capacity, Key::Zero()),
+      values_(capacity, 0.f)
+{
+}
+
+auto LinkScoreCache::make_key(const Eigen::Matrix3f& rotation,
+                              const Eigen::Vector3f& translation) -> Key
+{
+    Key key;
+    key.head<9>() = Eigen::Map<const Eigen::Matrix<float, 9, 1>>(
+        rotation.data());
+    key.tail<3>() = translation;
+    return key;
+}
+
+std::uint64_t LinkScoreCache::hash(const Key& key)
+{
+    // FNV-1a over the bytes of the pose
+    unsigned char bytes[sizeof(float) * 12];
+    std::memcpy(bytes, key.data(), sizeof(bytes));
+
+    std::uint64_t value = 14695981039346656037ull;
+    for (unsigned char byte : bytes)
+    {
+        value = (value ^ byte) * 1099511628211ull;
+    }
+    return value;
+}
+
+int LinkScoreCache::probe(const Key& key, std::uint64_t key_hash) const
+{
+    const int slots = capacity();
+    int slot = key_hash % slots;
+    for (int step = 0; step < slots; ++step)
+    {
+        if (generations_[slot] != generation_) return slot;
+        if (hashes_[slot] == key_hash && keys_[slot] == key) return slot;
+        slot = (slot + 1) % slots;
+    }
+    return -1;
+}
+
+bool LinkScoreCache::find(const Eigen::Matrix3f& rotation,
+                          const Eigen::Vector3f& translation,
+                          float& value) const
+{
+    if (size_ == 0) return false;
+
+    const Key key = make_key(rotation, translation);
+    const int slot = probe(key, hash(key));
+    if (slot < 0 || generations_[slot] != generation_) return false;
+
+    value = values_[slot];
+    return true;
+}
+
+void LinkScoreCache::insert(const Eigen::Matrix3f& rotation,
+                            const Eigen::Vector3f& translation,
+                            float value)
+{
+    // keep the probe sequences short
+    if (2 * (size_ + 1) > capacity()) return;
+
+    const Key key = make_key(rotation, translation);
+    const std::uint64_t key_hash = hash(key);
+    const int slot = probe(key, key_hash);
+    if (slot < 0) return;
+
+    if (generations_[slot] != generation_)
+    {
+        generations_[slot] = generation_;
+        hashes_[slot] = key_hash;
+        keys_[slot] = key;
+        ++size_;
+    }
+    values_[slot] = value;
+}
+
+void LinkScoreCache::clear()
+{
+    size_ = 0;
+    if (++generation_ == 0)
+    {
+        // wrapped around, stale generations could match again
+        std::fill(generations_.begin(), generations_.end(), 0);
+        generation_ = 1;
+    }
+}
+}
@@ -0,0 +1,86 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file link_score_cache.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Fixed capacity table of the log-likelihood contribution of a single
+ *     link by its pose in the camera frame.
+ *
+ * While the coordinate particle filter samples one block of joints, the
+ * links upstream of the block keep the pose of their parent particle. Their
+ * contributions are looked up instead of being evaluated again, such that
+ * only the links moved by the block are scored. Poses are compared exactly.
+ *
+ * Open addressing with linear probing. The table is cleared in O(1) by
+ * advancing a generation counter and does not allocate after construction.
+ * Once it is half full, no further poses are inserted.
+ */
+class LinkScoreCache
+{
+public:
+    explicit LinkScoreCache(int capacity = 0);
+
+    /**
+     * \brief Returns true and the stored value if the pose is known
+     */
+    bool find(const Eigen::Matrix3f& rotation,
+              const Eigen::Vector3f& translation,
+              float& value) const;
+
+    void insert(const Eigen::Matrix3f& rotation,
+                const Eigen::Vector3f& translation,
+                float value);
+
+    /**
+     * \brief Removes all entries
+     */
+    void clear();
+
+    int size() const { return size_; }
+    int capacity() const { return generations_.size(); }
+
+private:
+    typedef Eigen::Matrix<float, 12, 1> Key;
+
+    static Key make_key(const Eigen::Matrix3f& rotation,
+                        const Eigen::Vector3f& translation);
+    static std::uint64_t hash(const Key& key);
+
+    /**
+     * \brief Slot holding the key or the empty slot ending its probe
+     *     sequence
+     */
+    int probe(const Key& key, std::uint64_t key_hash) const;
+
+private:
+    std::uint32_t generation_;
+    int size_;
+    // a slot is occupied if its generation is the current one
+    std::vector<std::uint32_t> generations_;
+    std::vector<std::uint64_t> hashes_;
+    std::vector<Key, Eigen::aligned_allocator<Key>> keys_;
+    std::vector<float> values_;
+};
+}
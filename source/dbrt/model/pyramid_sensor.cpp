@@ -0,0 +1,150 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file pyramid_sensor.cpp
+ * \date October 2026
+ */
+
+#include <algorithm>
+#include <dbrt/model/pyramid_sensor.h>
+
+namespace dbrt
+{
+PyramidSensor::PyramidSensor(const std::vector<std::shared_ptr<Base>>& levels,
+                             const CameraGeometry& camera_geometry,
+                             const Parameters& parameters)
+    : levels_(levels), parameters_(parameters), images_(levels.size())
+{
+    int factor = 1;
+    for (size_t level = 0; level < levels_.size(); ++level)
+    {
+        widths_.push_back(camera_geometry.width() / factor);
+        heights_.push_back(camera_geometry.height() / factor);
+        factor *= parameters_.factor;
+    }
+}
+
+void PyramidSensor::set_observation(const Observation& image)
+{
+    // each level keeps every factor-th pixel of every factor-th row of the
+    // next finer level
+    levels_[0]->set_observation(image);
+    const Observation* finer = &image;
+    for (size_t level = 1; level < levels_.size(); ++level)
+    {
+        Observation& coarser = images_[level];
+        coarser.resize(widths_[level] * heights_[level]);
+        for (int v = 0; v < heights_[level]; ++v)
+        {
+            for (int u = 0; u < widths_[level]; ++u)
+            {
+                coarser(v * widths_[level] + u) =
+                    (*finer)(v * parameters_.factor * widths_[level - 1] +
+                             u * parameters_.factor);
+            }
+        }
+        levels_[level]->set_observation(coarser);
+        finer = &coarser;
+    }
+}
+
+void PyramidSensor::reset()
+{
+    for (auto& level : levels_)
+    {
+        level->reset();
+    }
+}
+
+auto PyramidSensor::loglikes(const StateArray& states,
+                             IntArray& indices,
+                             const bool& update) -> RealArray
+{
+    RealArray loglikes = levels_.back()->loglikes(states, indices, update);
+    if (states.size() == 0) return loglikes;
+
+    candidates_.resize(states.size());
+    for (int i = 0; i < states.size(); ++i)
+    {
+        candidates_[i] = i;
+    }
+
+    const double scale = parameters_.factor * parameters_.factor;
+    for (int level = int(levels_.size()) - 2; level >= 0; --level)
+    {
+        loglikes *= scale;
+        select_candidates(loglikes);
+
+        const int count = candidates_.size();
+        candidate_states_.resize(count);
+        candidate_indices_.resize(count);
+        for (int k = 0; k < count; ++k)
+        {
+            candidate_states_(k) = states(candidates_[k]);
+            candidate_indices_(k) = k;
+        }
+
+        const RealArray refined = levels_[level]->loglikes(
+            candidate_states_, candidate_indices_, update);
+
+        double offset = 0.;
+        double worst = refined(0);
+        for (int k = 0; k < count; ++k)
+        {
+            offset += (refined(k) - loglikes(candidates_[k])) / count;
+            worst = std::min<double>(worst, refined(k));
+        }
+
+        is_candidate_.assign(states.size(), false);
+        for (int k = 0; k < count; ++k)
+        {
+            loglikes(candidates_[k]) = refined(k);
+            is_candidate_[candidates_[k]] = true;
+        }
+        for (int i = 0; i < states.size(); ++i)
+        {
+            if (is_candidate_[i]) continue;
+            loglikes(i) = std::min<double>(loglikes(i) + offset, worst);
+        }
+    }
+
+    return loglikes;
+}
+
+void PyramidSensor::select_candidates(const RealArray& loglikes)
+{
+    std::sort(candidates_.begin(), candidates_.end(), [&](int a, int b) {
+        return loglikes(a) > loglikes(b);
+    });
+
+    int count = candidates_.size();
+    if (parameters_.refine_count > 0)
+    {
+        count = std::min(count, parameters_.refine_count);
+    }
+    if (parameters_.refine_margin > 0.)
+    {
+        const double threshold =
+            loglikes(candidates_[0]) - parameters_.refine_margin;
+        int within = 1;
+        while (within < count && loglikes(candidates_[within]) >= threshold)
+        {
+            ++within;
+        }
+        count = within;
+    }
+
+    candidates_.resize(count);
+}
+}
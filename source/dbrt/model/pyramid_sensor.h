@@ -0,0 +1,104 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file pyramid_sensor.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <dbot/model/rao_blackwell_sensor.h>
+#include <dbrt/robot_state.h>
+#include <dbrt/util/camera_geometry.h>
+#include <memory>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Coarse-to-fine evaluation of a sensor model on an image pyramid.
+ *
+ * All states are scored on the coarsest level. At each finer level only the
+ * best states of the coarser level are rescored. The level sensors must
+ * score sums over pixels, hence the coarser values are scaled by the pixel
+ * ratio between the levels. The states which are not rescored are shifted by
+ * the mean difference between the finer and the scaled coarser values of the
+ * rescored states and capped at the worst rescored value, such that they
+ * never outrank a rescored state.
+ *
+ * The level sensors must not keep per-particle state, since the resampling
+ * indices are not passed through.
+ */
+class PyramidSensor : public dbot::RbSensor<RobotState<>>
+{
+public:
+    typedef dbot::RbSensor<RobotState<>> Base;
+    typedef Base::State State;
+    typedef Base::StateArray StateArray;
+    typedef Base::RealArray RealArray;
+    typedef Base::IntArray IntArray;
+    typedef Base::Observation Observation;
+
+    struct Parameters
+    {
+        // downsampling factor between successive levels
+        int factor;
+        // states rescored at each finer level, 0 for no limit
+        int refine_count;
+        // only states within this log-likelihood margin of the best state
+        // are rescored, 0 for no limit
+        double refine_margin;
+    };
+
+public:
+    /**
+     * \param levels
+     *     sensors from fine to coarse, the first one observing the image of
+     *     the given geometry, each further one the image downsampled by the
+     *     level factor
+     */
+    PyramidSensor(const std::vector<std::shared_ptr<Base>>& levels,
+                  const CameraGeometry& camera_geometry,
+                  const Parameters& parameters);
+
+    virtual RealArray loglikes(const StateArray& states,
+                               IntArray& indices,
+                               const bool& update = false);
+
+    virtual void set_observation(const Observation& image);
+
+    virtual void reset();
+
+private:
+    /**
+     * \brief Keeps the best of the candidate states according to the
+     *     refinement parameters
+     */
+    void select_candidates(const RealArray& loglikes);
+
+private:
+    std::vector<std::shared_ptr<Base>> levels_;
+    std::vector<int> widths_;
+    std::vector<int> heights_;
+    Parameters parameters_;
+
+    std::vector<Observation> images_;
+
+    // indices of the states rescored at the current level
+    std::vector<int> candidates_;
+    std::vector<bool> is_candidate_;
+    StateArray candidate_states_;
+    IntArray candidate_indices_;
+};
+}
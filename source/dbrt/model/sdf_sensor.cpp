@@ -0,0 +1,231 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file sdf_sensor.cpp
+ * \date October 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <dbrt/model/sdf_sensor.h>
+#include <dbrt/util/pixel_subset.h>
+#include <mutex>
+#include <ros/ros.h>
+
+namespace dbrt
+{
+SdfSensor::SdfSensor(const std::shared_ptr<KinematicsFromURDF>& kinematics,
+                     const CameraGeometry& camera_geometry,
+                     const std::vector<SignedDistanceField>& fields,
+                     const Parameters& parameters)
+    : kinematics_(kinematics),
+      camera_geometry_(camera_geometry),
+      fields_(fields),
+      parameters_(parameters),
+      truncation_(0.f),
+      points_selected_(false),
+      point_scale_(1.),
+      valid_count_(0),
+      generator_(0),
+      effective_sample_size_(0.)
+{
+    for (const auto& field : fields_)
+    {
+        truncation_ = std::max(truncation_, field.truncation());
+    }
+}
+
+void SdfSensor::set_observation(const Observation& image)
+{
+    camera_geometry_.back_project(image, cloud_);
+    points_selected_ = false;
+}
+
+void SdfSensor::reset()
+{
+}
+
+auto SdfSensor::loglikes(const StateArray& states,
+                         IntArray& indices,
+                         const bool& update) -> RealArray
+{
+    update_link_poses(states);
+    if (!points_selected_) select_points(states.size());
+
+    // points beyond the truncation distance of all links contribute this
+    // constant, which is subtracted from every point
+    const double baseline = point_loglike(truncation_);
+
+    const int link_count = fields_.size();
+    RealArray loglikes = RealArray::Zero(states.size());
+    for (int i = 0; i < states.size(); ++i)
+    {
+        const int offset = i * link_count;
+
+        double loglike = 0.;
+        for (const Eigen::Vector3f& point : points_)
+        {
+            float distance = truncation_;
+            for (int link = 0; link < link_count; ++link)
+            {
+                if ((point - centers_[offset + link]).squaredNorm() >
+                    squared_radii_[link])
+                {
+                    continue;
+                }
+
+                const Eigen::Vector3f link_point =
+                    rotations_[offset + link] * point +
+                    translations_[offset + link];
+                // union of the links, i.e. negative inside of any link
+                distance =
+                    std::min(distance, fields_[link].distance(link_point));
+            }
+
+            if (distance < truncation_)
+            {
+                loglike += point_loglike(distance) - baseline;
+            }
+        }
+        loglikes(i) = point_scale_ * loglike;
+    }
+
+    effective_sample_size_ = dbrt::effective_sample_size(loglikes);
+    if (subsampling())
+    {
+        ROS_INFO_THROTTLE(10.,
+                          "SDF sensor scores %d of %d valid pixels in the "
+                          "robot region, effective sample size %.1f of %d",
+                          int(points_.size()),
+                          valid_count_,
+                          effective_sample_size_,
+                          int(states.size()));
+    }
+
+    return loglikes;
+}
+
+void SdfSensor::select_points(int state_count)
+{
+    points_selected_ = true;
+    points_.clear();
+    point_scale_ = 1.;
+
+    if (!subsampling())
+    {
+        for (int i = 0; i < cloud_.size(); ++i)
+        {
+            if (cloud_.valid(i)) points_.push_back(cloud_.point(i));
+        }
+        return;
+    }
+
+    // image region covered by the links of all states
+    const int link_count = fields_.size();
+    PixelRoi roi = PixelRoi::none();
+    for (int i = 0; i < state_count * link_count; ++i)
+    {
+        if (squared_radii_[i % link_count] < 0.f) continue;
+        roi.merge(camera_geometry_.project_sphere(
+            centers_[i], std::sqrt(squared_radii_[i % link_count])));
+    }
+
+    int valid_count = 0;
+    for (int v = roi.v_min; v <= roi.v_max; ++v)
+    {
+        for (int u = roi.u_min; u <= roi.u_max; ++u)
+        {
+            valid_count += cloud_.valid(v * camera_geometry_.width() + u);
+        }
+    }
+
+    const int count =
+        parameters_.subset_count > 0
+            ? parameters_.subset_count
+            : int(std::ceil(parameters_.subset_fraction * valid_count));
+    stratified_pixel_subset(
+        cloud_, camera_geometry_.width(), roi, count, generator_, subset_);
+
+    for (int pixel : subset_)
+    {
+        points_.push_back(cloud_.point(pixel));
+    }
+    if (!points_.empty()) point_scale_ = double(valid_count) / points_.size();
+    valid_count_ = valid_count;
+}
+
+bool SdfSensor::subsampling() const
+{
+    return parameters_.subset_count > 0 ||
+           (parameters_.subset_fraction > 0. &&
+            parameters_.subset_fraction < 1.);
+}
+
+void SdfSensor::update_link_poses(const StateArray& states)
+{
+    const int link_count = fields_.size();
+    rotations_.resize(states.size() * link_count);
+    translations_.resize(states.size() * link_count);
+    centers_.resize(states.size() * link_count);
+    squared_radii_.resize(link_count);
+
+    for (int link = 0; link < link_count; ++link)
+    {
+        squared_radii_[link] =
+            fields_[link].empty()
+                ? -1.f
+                : fields_[link].radius() * fields_[link].radius();
+    }
+
+    // the kinematics are shared with the robot states
+    std::lock_guard<std::mutex> lock(*RobotState<>::kinematics_mutex_);
+    for (int i = 0; i < states.size(); ++i)
+    {
+        kinematics_->set_joint_angles(states(i));
+        for (int link = 0; link < link_count; ++link)
+        {
+            if (fields_[link].empty()) continue;
+
+            // link to camera transform
+            const Eigen::Matrix3f rotation =
+                kinematics_->get_link_orientation(link)
+                    .toRotationMatrix()
+                    .cast<float>();
+            const Eigen::Vector3f translation =
+                kinematics_->get_link_position(link).cast<float>();
+
+            const int index = i * link_count + link;
+            rotations_[index] = rotation.transpose();
+            translations_[index] = -(rotations_[index] * translation);
+            centers_[index] = rotation * fields_[link].center() + translation;
+        }
+    }
+}
+
+double SdfSensor::point_loglike(double distance) const
+{
+    const double normalized = distance / parameters_.distance_sigma;
+    double loglike = std::log(std::exp(-0.5 * normalized * normalized) +
+                              parameters_.tail_weight);
+
+    // points inside a link lie in space the link would occlude, i.e. they
+    // are evidence against the state
+    if (distance < 0.)
+    {
+        loglike += parameters_.free_space_penalty * distance / truncation_;
+    }
+
+    return loglike;
+}
+}
@@ -0,0 +1,143 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file sdf_sensor.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <dbot/model/rao_blackwell_sensor.h>
+#include <dbrt/kinematics_from_urdf.h>
+#include <dbrt/model/signed_distance_field.h>
+#include <dbrt/robot_state.h>
+#include <dbrt/util/camera_geometry.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Depth image sensor model scoring robot states without rendering.
+ *
+ * The observed depth pixels are back-projected once per image. For each
+ * state, the points are transformed into the frames of the nearby links and
+ * the distance to the closest link surface is looked up in the precomputed
+ * signed distance fields. Each point contributes a Gaussian in that distance
+ * mixed with a uniform outlier term. Points inside of a link violate the
+ * free space in front of the observed surface and are penalized in
+ * proportion to their depth within the link. Points further than the
+ * truncation distance from all links contribute a constant and are skipped.
+ *
+ * Optionally, only a random subset of the observed points is scored. The
+ * subset is drawn once per image, stratified over the image region covered
+ * by the links of the first batch of states, and shared by all states. The
+ * log-likelihoods are scaled by the inverse subset fraction.
+ *
+ * The model has no per-particle state, hence the resampling indices are
+ * ignored.
+ */
+class SdfSensor : public dbot::RbSensor<RobotState<>>
+{
+public:
+    typedef dbot::RbSensor<RobotState<>> Base;
+    typedef Base::State State;
+    typedef Base::StateArray StateArray;
+    typedef Base::RealArray RealArray;
+    typedef Base::IntArray IntArray;
+    typedef Base::Observation Observation;
+
+    struct Parameters
+    {
+        // standard deviation of the point to surface distance in meters
+        double distance_sigma;
+        // weight of the uniform outlier term relative to the Gaussian peak
+        double tail_weight;
+        // log-likelihood penalty of a point at the truncation distance
+        // inside of a link, decreasing linearly towards the surface
+        double free_space_penalty;
+        // number of scored points per image, 0 to use subset_fraction
+        int subset_count;
+        // fraction of the valid pixels within the robot region which is
+        // scored, 0 or 1 to score all points
+        double subset_fraction;
+    };
+
+public:
+    SdfSensor(const std::shared_ptr<KinematicsFromURDF>& kinematics,
+              const CameraGeometry& camera_geometry,
+              const std::vector<SignedDistanceField>& fields,
+              const Parameters& parameters);
+
+    virtual RealArray loglikes(const StateArray& states,
+                               IntArray& indices,
+                               const bool& update = false);
+
+    virtual void set_observation(const Observation& image);
+
+    virtual void reset();
+
+    /**
+     * \brief Number of points scored for the current image
+     */
+    int scored_point_count() const { return points_.size(); }
+
+    /**
+     * \brief Effective sample size of the last evaluated batch of states
+     */
+    double effective_sample_size() const { return effective_sample_size_; }
+
+private:
+    /**
+     * \brief Computes the link poses of all states, i.e. the transforms
+     *     from the camera into the link frames, and the link bounding spheres
+     */
+    void update_link_poses(const StateArray& states);
+
+    /**
+     * \brief Selects the scored points of the current image. Draws the
+     *     subset within the region covered by the links of all states.
+     */
+    void select_points(int state_count);
+
+    bool subsampling() const;
+
+    double point_loglike(double distance) const;
+
+private:
+    std::shared_ptr<KinematicsFromURDF> kinematics_;
+    CameraGeometry camera_geometry_;
+    std::vector<SignedDistanceField> fields_;
+    Parameters parameters_;
+    float truncation_;
+
+    // observed points in the camera frame, all and the scored ones
+    PointCloud cloud_;
+    std::vector<Eigen::Vector3f> points_;
+    bool points_selected_;
+    double point_scale_;
+    int valid_count_;
+    std::vector<int> subset_;
+    std::mt19937 generator_;
+    double effective_sample_size_;
+
+    // camera to link transforms and link bounding spheres in the camera
+    // frame of all states, state major
+    std::vector<Eigen::Matrix3f> rotations_;
+    std::vector<Eigen::Vector3f> translations_;
+    std::vector<Eigen::Vector3f> centers_;
+    std::vector<float> squared_radii_;
+};
+}
@@ -0,0 +1,392 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file signed_distance_field.cpp
+ * \date October 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <dbrt/model/signed_distance_field.h>
+#include <fstream>
+#include <limits>
+#include <ros/ros.h>
+
+namespace dbrt
+{
+namespace
+{
+const char cache_magic[8] = {'D', 'B', 'R', 'T', 'S', 'D', 'F', '1'};
+
+/**
+ * \brief Closest point on the triangle abc, see Ericson, Real-Time Collision
+ *     Detection, 5.1.5
+ */
+Eigen::Vector3d closest_point_on_triangle(const Eigen::Vector3d& p,
+                                          const Eigen::Vector3d& a,
+                                          const Eigen::Vector3d& b,
+                                          const Eigen::Vector3d& c)
+{
+    const Eigen::Vector3d ab = b - a;
+    const Eigen::Vector3d ac = c - a;
+    const Eigen::Vector3d ap = p - a;
+    const double d1 = ab.dot(ap);
+    const double d2 = ac.dot(ap);
+    if (d1 <= 0. && d2 <= 0.) return a;
+
+    const Eigen::Vector3d bp = p - b;
+    const double d3 = ab.dot(bp);
+    const double d4 = ac.dot(bp);
+    if (d3 >= 0. && d4 <= d3) return b;
+
+    const double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0. && d1 >= 0. && d3 <= 0.) return a + d1 / (d1 - d3) * ab;
+
+    const Eigen::Vector3d cp = p - c;
+    const double d5 = ab.dot(cp);
+    const double d6 = ac.dot(cp);
+    if (d6 >= 0. && d5 <= d6) return c;
+
+    const double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0. && d2 >= 0. && d6 <= 0.) return a + d2 / (d2 - d6) * ac;
+
+    const double va = d3 * d6 - d5 * d4;
+    if (va <= 0. && d4 - d3 >= 0. && d5 - d6 >= 0.)
+    {
+        return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+    }
+
+    const double denominator = 1. / (va + vb + vc);
+    return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+/**
+ * \brief FNV-1a hash over the raw bytes
+ */
+void hash_bytes(const void* data, std::size_t size, std::uint64_t& hash)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+std::uint64_t hash_model(const dbot::ObjectModel& object_model,
+                         double voxel_size,
+                         double truncation)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    hash_bytes(&voxel_size, sizeof(voxel_size), hash);
+    hash_bytes(&truncation, sizeof(truncation), hash);
+    for (int part = 0; part < object_model.count_parts(); ++part)
+    {
+        for (const auto& vertex : object_model.vertices()[part])
+        {
+            hash_bytes(vertex.data(), 3 * sizeof(double), hash);
+        }
+        for (const auto& triangle : object_model.triangle_indices()[part])
+        {
+            hash_bytes(triangle.data(), triangle.size() * sizeof(int), hash);
+        }
+    }
+    return hash;
+}
+
+bool read_cache(const std::string& cache_file,
+                std::uint64_t hash,
+                int count,
+                std::vector<SignedDistanceField>& fields)
+{
+    std::ifstream stream(cache_file, std::ios::binary);
+    if (!stream) return false;
+
+    char magic[sizeof(cache_magic)];
+    std::uint64_t cached_hash;
+    std::int32_t cached_count;
+    stream.read(magic, sizeof(magic));
+    stream.read(reinterpret_cast<char*>(&cached_hash), sizeof(cached_hash));
+    stream.read(reinterpret_cast<char*>(&cached_count), sizeof(cached_count));
+    if (!stream || std::memcmp(magic, cache_magic, sizeof(magic)) != 0 ||
+        cached_hash != hash || cached_count != count)
+    {
+        return false;
+    }
+
+    fields.resize(count);
+    for (auto& field : fields)
+    {
+        if (!field.read(stream)) return false;
+    }
+    return true;
+}
+
+void write_cache(const std::string& cache_file,
+                 std::uint64_t hash,
+                 const std::vector<SignedDistanceField>& fields)
+{
+    std::ofstream stream(cache_file, std::ios::binary | std::ios::trunc);
+    const std::int32_t count = fields.size();
+    stream.write(cache_magic, sizeof(cache_magic));
+    stream.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+    stream.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& field : fields)
+    {
+        field.write(stream);
+    }
+
+    if (!stream)
+    {
+        ROS_WARN("Failed to write signed distance field cache %s",
+                 cache_file.c_str());
+    }
+}
+}
+
+SignedDistanceField::SignedDistanceField()
+    : origin_(Eigen::Vector3f::Zero()),
+      voxel_size_(1.f),
+      truncation_(0.f),
+      size_(Eigen::Vector3i::Zero())
+{
+}
+
+SignedDistanceField SignedDistanceField::from_mesh(
+    const std::vector<Eigen::Vector3d>& vertices,
+    const std::vector<std::vector<int>>& triangles,
+    double voxel_size,
+    double truncation)
+{
+    SignedDistanceField field;
+    field.voxel_size_ = voxel_size;
+    field.truncation_ = truncation;
+    if (vertices.empty() || triangles.empty()) return field;
+
+    // bounding box padded such that the border voxels are outside the band
+    Eigen::Vector3d lower = vertices[0];
+    Eigen::Vector3d upper = vertices[0];
+    for (const auto& vertex : vertices)
+    {
+        lower = lower.cwiseMin(vertex);
+        upper = upper.cwiseMax(vertex);
+    }
+    const double padding = truncation + 2. * voxel_size;
+    lower.array() -= padding;
+    upper.array() += padding;
+
+    field.origin_ = lower.cast<float>();
+    for (int i = 0; i < 3; ++i)
+    {
+        field.size_(i) = int(std::ceil((upper(i) - lower(i)) / voxel_size)) + 1;
+    }
+
+    const int dy = field.size_.x();
+    const int dz = field.size_.x() * field.size_.y();
+    const int voxel_count = dz * field.size_.z();
+
+    // exact distances within the band, signed by the normal of the closest
+    // triangle. This is correct at convex and concave edges.
+    std::vector<double> band(voxel_count, std::numeric_limits<double>::max());
+    std::vector<signed char> signs(voxel_count, 0);
+    for (const auto& triangle : triangles)
+    {
+        const Eigen::Vector3d& a = vertices[triangle[0]];
+        const Eigen::Vector3d& b = vertices[triangle[1]];
+        const Eigen::Vector3d& c = vertices[triangle[2]];
+        const Eigen::Vector3d normal = (b - a).cross(c - a);
+
+        const Eigen::Vector3d triangle_lower =
+            a.cwiseMin(b).cwiseMin(c).array() - truncation;
+        const Eigen::Vector3d triangle_upper =
+            a.cwiseMax(b).cwiseMax(c).array() + truncation;
+        Eigen::Vector3i begin, end;
+        for (int i = 0; i < 3; ++i)
+        {
+            begin(i) = std::max(
+                int(std::floor((triangle_lower(i) - lower(i)) / voxel_size)),
+                0);
+            end(i) = std::min(
+                int(std::ceil((triangle_upper(i) - lower(i)) / voxel_size)),
+                field.size_(i) - 1);
+        }
+
+        for (int z = begin.z(); z <= end.z(); ++z)
+        {
+            for (int y = begin.y(); y <= end.y(); ++y)
+            {
+                for (int x = begin.x(); x <= end.x(); ++x)
+                {
+                    const Eigen::Vector3d point =
+                        lower + voxel_size * Eigen::Vector3d(x, y, z);
+                    const Eigen::Vector3d offset =
+                        point - closest_point_on_triangle(point, a, b, c);
+                    const double distance = offset.norm();
+
+                    const int index = x + dy * y + dz * z;
+                    if (distance >= truncation || distance >= band[index])
+                    {
+                        continue;
+                    }
+                    band[index] = distance;
+                    signs[index] = offset.dot(normal) < 0. ? -1 : 1;
+                }
+            }
+        }
+    }
+
+    // flood fill the space outside the band from the grid border. Voxels
+    // which cannot be reached are enclosed by the mesh. The padded border is
+    // connected and outside the band, hence seeding two of its faces
+    // suffices.
+    std::vector<bool> outside(voxel_count, false);
+    std::vector<int> queue;
+    auto visit = [&](int x, int y, int z) {
+        if (x < 0 || y < 0 || z < 0 || x >= field.size_.x() ||
+            y >= field.size_.y() || z >= field.size_.z())
+        {
+            return;
+        }
+        const int index = x + dy * y + dz * z;
+        if (outside[index] || signs[index] != 0) return;
+        outside[index] = true;
+        queue.push_back(index);
+    };
+    for (int z = 0; z < field.size_.z(); ++z)
+    {
+        for (int y = 0; y < field.size_.y(); ++y)
+        {
+            visit(0, y, z);
+            visit(field.size_.x() - 1, y, z);
+        }
+    }
+    while (!queue.empty())
+    {
+        const int index = queue.back();
+        queue.pop_back();
+        const int x = index % dy;
+        const int y = (index / dy) % field.size_.y();
+        const int z = index / dz;
+        visit(x - 1, y, z);
+        visit(x + 1, y, z);
+        visit(x, y - 1, z);
+        visit(x, y + 1, z);
+        visit(x, y, z - 1);
+        visit(x, y, z + 1);
+    }
+
+    field.values_.resize(voxel_count);
+    for (int i = 0; i < voxel_count; ++i)
+    {
+        if (signs[i] != 0)
+        {
+            field.values_[i] = signs[i] * band[i];
+        }
+        else
+        {
+            field.values_[i] = outside[i] ? truncation : -truncation;
+        }
+    }
+
+    return field;
+}
+
+Eigen::Vector3f SignedDistanceField::center() const
+{
+    return origin_ + 0.5f * voxel_size_ *
+                         (size_.cast<float>() - Eigen::Vector3f::Ones());
+}
+
+float SignedDistanceField::radius() const
+{
+    return 0.5f * voxel_size_ *
+           (size_.cast<float>() - Eigen::Vector3f::Ones()).norm();
+}
+
+void SignedDistanceField::write(std::ostream& stream) const
+{
+    stream.write(reinterpret_cast<const char*>(origin_.data()),
+                 3 * sizeof(float));
+    stream.write(reinterpret_cast<const char*>(&voxel_size_), sizeof(float));
+    stream.write(reinterpret_cast<const char*>(&truncation_), sizeof(float));
+    stream.write(reinterpret_cast<const char*>(size_.data()), 3 * sizeof(int));
+    stream.write(reinterpret_cast<const char*>(values_.data()),
+                 values_.size() * sizeof(float));
+}
+
+bool SignedDistanceField::read(std::istream& stream)
+{
+    stream.read(reinterpret_cast<char*>(origin_.data()), 3 * sizeof(float));
+    stream.read(reinterpret_cast<char*>(&voxel_size_), sizeof(float));
+    stream.read(reinterpret_cast<char*>(&truncation_), sizeof(float));
+    stream.read(reinterpret_cast<char*>(size_.data()), 3 * sizeof(int));
+    if (!stream || size_.minCoeff() < 0) return false;
+
+    // the values must fit into the rest of the stream, which bounds the
+    // allocation for corrupted files
+    const std::streampos position = stream.tellg();
+    stream.seekg(0, std::ios::end);
+    const std::streampos end = stream.tellg();
+    stream.seekg(position);
+    if (!stream || position < 0 || end < position) return false;
+
+    std::uint64_t count = (end - position) / sizeof(float);
+    for (int i = 0; i < 3; ++i)
+    {
+        if (size_(i) == 0) break;
+        if (std::uint64_t(size_(i)) > count) return false;
+        count /= size_(i);
+    }
+
+    values_.resize(std::size_t(size_.x()) * size_.y() * size_.z());
+    stream.read(reinterpret_cast<char*>(values_.data()),
+                values_.size() * sizeof(float));
+    return bool(stream);
+}
+
+std::vector<SignedDistanceField> create_signed_distance_fields(
+    const dbot::ObjectModel& object_model,
+    double voxel_size,
+    double truncation,
+    const std::string& cache_file)
+{
+    const std::uint64_t hash =
+        hash_model(object_model, voxel_size, truncation);
+    const int count = object_model.count_parts();
+
+    std::vector<SignedDistanceField> fields;
+    if (!cache_file.empty() && read_cache(cache_file, hash, count, fields))
+    {
+        ROS_INFO("Loaded signed distance fields from %s", cache_file.c_str());
+        return fields;
+    }
+
+    fields.resize(count);
+    for (int part = 0; part < count; ++part)
+    {
+        fields[part] = SignedDistanceField::from_mesh(
+            object_model.vertices()[part],
+            object_model.triangle_indices()[part],
+            voxel_size,
+            truncation);
+    }
+    ROS_INFO("Computed signed distance fields of %d parts", count);
+
+    if (!cache_file.empty()) write_cache(cache_file, hash, fields);
+
+    return fields;
+}
+}
@@ -0,0 +1,128 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file signed_distance_field.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Core>
+#include <dbot/object_model.h>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Truncated signed distance field of a mesh on a regular voxel grid.
+ *
+ * Distances are positive outside and negative inside of the mesh and clamped
+ * to the truncation distance. Only the band around the surface holds exact
+ * distances. The grid is padded such that its border is outside of the band,
+ * hence points outside of the grid have the truncation distance.
+ */
+class SignedDistanceField
+{
+public:
+    SignedDistanceField();
+
+    /**
+     * \brief Voxelizes the triangle mesh given in its own frame. Inside and
+     *     outside are told apart by a flood fill from the grid border, i.e.
+     *     the mesh is expected to be closed.
+     */
+    static SignedDistanceField from_mesh(
+        const std::vector<Eigen::Vector3d>& vertices,
+        const std::vector<std::vector<int>>& triangles,
+        double voxel_size,
+        double truncation);
+
+    /**
+     * \brief Trilinear interpolation of the distance at the given point in
+     *     the mesh frame
+     */
+    float distance(const Eigen::Vector3f& point) const
+    {
+        const Eigen::Vector3f grid = (point - origin_) / voxel_size_;
+        if (!(grid.x() >= 0.f && grid.y() >= 0.f && grid.z() >= 0.f &&
+              grid.x() < size_.x() - 1 && grid.y() < size_.y() - 1 &&
+              grid.z() < size_.z() - 1))
+        {
+            return truncation_;
+        }
+
+        const int x = int(grid.x());
+        const int y = int(grid.y());
+        const int z = int(grid.z());
+        const float fx = grid.x() - x;
+        const float fy = grid.y() - y;
+        const float fz = grid.z() - z;
+
+        const int dy = size_.x();
+        const int dz = size_.x() * size_.y();
+        const float* v = &values_[x + dy * y + dz * z];
+
+        const float c00 = v[0] + fx * (v[1] - v[0]);
+        const float c10 = v[dy] + fx * (v[dy + 1] - v[dy]);
+        const float c01 = v[dz] + fx * (v[dz + 1] - v[dz]);
+        const float c11 = v[dz + dy] + fx * (v[dz + dy + 1] - v[dz + dy]);
+        const float c0 = c00 + fy * (c10 - c00);
+        const float c1 = c01 + fy * (c11 - c01);
+        return c0 + fz * (c1 - c0);
+    }
+
+    /**
+     * \brief Center and radius of the sphere enclosing the grid
+     */
+    Eigen::Vector3f center() const;
+    float radius() const;
+
+    bool empty() const { return values_.empty(); }
+    float truncation() const { return truncation_; }
+    float voxel_size() const { return voxel_size_; }
+    const Eigen::Vector3i& size() const { return size_; }
+
+    void write(std::ostream& stream) const;
+
+    /**
+     * \brief Reads a field written by write(). Returns false if the stream
+     *     ends prematurely.
+     */
+    bool read(std::istream& stream);
+
+private:
+    Eigen::Vector3f origin_;
+    float voxel_size_;
+    float truncation_;
+    Eigen::Vector3i size_;
+    // x runs fastest
+    std::vector<float> values_;
+};
+
+/**
+ * \brief Creates the signed distance fields of all parts of the object model.
+ *
+ * Voxelizing is costly for detailed meshes, hence the fields are stored in
+ * the given cache file. The cache is used if it was written for identical
+ * meshes and grid parameters, otherwise it is rewritten. An empty file name
+ * disables the cache.
+ */
+std::vector<SignedDistanceField> create_signed_distance_fields(
+    const dbot::ObjectModel& object_model,
+    double voxel_size,
+    double truncation,
+    const std::string& cache_file);
+}
@@ -0,0 +1,225 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file surface_point_sensor.cpp
+ * \date October 2026
+ */
+
+#include <cmath>
+#include <dbrt/model/surface_point_sensor.h>
+#include <dbrt/model/surface_sampler.h>
+#include <mutex>
+#include <ros/ros.h>
+
+namespace dbrt
+{
+SurfacePointSensor::SurfacePointSensor(
+    const std::shared_ptr<KinematicsFromURDF>& kinematics,
+    const std::shared_ptr<dbot::ObjectModel>& object_model,
+    const CameraGeometry& camera_geometry,
+    const Parameters& parameters,
+    const std::shared_ptr<const KinectLoglikeTable>& kinect_table)
+    : kinematics_(kinematics),
+      camera_geometry_(camera_geometry),
+      parameters_(parameters),
+      kinect_table_(kinect_table),
+      link_evaluations_(0),
+      link_cache_hits_(0),
+      link_cache_hit_fraction_(0.)
+{
+    // the object model has been loaded through the kinematics, i.e. its
+    // parts are ordered like the kinematics links
+    auto samples =
+        sample_surfaces(*object_model, parameters_.points_per_link, 0);
+
+    points_.resize(samples.size());
+    normals_.resize(samples.size());
+    for (size_t link = 0; link < samples.size(); ++link)
+    {
+        const int count = samples[link].points.size();
+        points_[link].resize(3, count);
+        normals_[link].resize(3, count);
+        for (int k = 0; k < count; ++k)
+        {
+            points_[link].col(k) = samples[link].points[k].cast<float>();
+            normals_[link].col(k) = samples[link].normals[k].cast<float>();
+        }
+    }
+
+    camera_points_.resize(3, parameters_.points_per_link);
+    camera_normals_.resize(3, parameters_.points_per_link);
+
+    if (parameters_.link_cache_size > 0)
+    {
+        link_caches_.assign(points_.size(),
+                            LinkScoreCache(parameters_.link_cache_size));
+    }
+}
+
+void SurfacePointSensor::set_observation(const Observation& image)
+{
+    // cached contributions refer to the previous image
+    clear_link_caches();
+
+    image_.resize(image.size());
+    for (int i = 0; i < image.size(); ++i)
+    {
+        image_[i] = image(i);
+    }
+}
+
+void SurfacePointSensor::reset()
+{
+    clear_link_caches();
+}
+
+void SurfacePointSensor::clear_link_caches()
+{
+    for (auto& cache : link_caches_)
+    {
+        cache.clear();
+    }
+
+    if (link_evaluations_ == 0) return;
+
+    link_cache_hit_fraction_ = double(link_cache_hits_) / link_evaluations_;
+    ROS_INFO_THROTTLE(10.,
+                      "Surface point sensor looked up %ld of %ld link "
+                      "evaluations (%.1f %%)",
+                      link_cache_hits_,
+                      link_evaluations_,
+                      100. * link_cache_hit_fraction_);
+    link_evaluations_ = 0;
+    link_cache_hits_ = 0;
+}
+
+auto SurfacePointSensor::loglikes(const StateArray& states,
+                                  IntArray& indices,
+                                  const bool& update) -> RealArray
+{
+    update_link_poses(states);
+
+    const float precision =
+        1.f / (parameters_.depth_sigma * parameters_.depth_sigma);
+    const float tail_weight = parameters_.tail_weight;
+    const float occlusion_weight = parameters_.occlusion_weight;
+    // points outside of the image or on missing depth are scored like
+    // points behind a far occluder, i.e. below any matched point. Otherwise
+    // moving links out of view or into holes would be rewarded.
+    const float unobserved = std::log(occlusion_weight);
+
+    const int link_count = points_.size();
+    RealArray loglikes = RealArray::Zero(states.size());
+    for (int link = 0; link < link_count; ++link)
+    {
+        const int count = points_[link].cols();
+        if (count == 0) continue;
+
+        for (int i = 0; i < states.size(); ++i)
+        {
+            const Eigen::Matrix3f& rotation = rotations_[i * link_count + link];
+            const Eigen::Vector3f& translation =
+                translations_[i * link_count + link];
+
+            // the link has not moved relative to an evaluated state
+            float loglike = 0.f;
+            if (!link_caches_.empty())
+            {
+                link_evaluations_++;
+                if (link_caches_[link].find(rotation, translation, loglike))
+                {
+                    link_cache_hits_++;
+                    loglikes(i) += loglike;
+                    continue;
+                }
+            }
+
+            camera_points_.leftCols(count).noalias() =
+                rotation * points_[link];
+            camera_points_.leftCols(count).colwise() += translation;
+            camera_normals_.leftCols(count).noalias() =
+                rotation * normals_[link];
+
+            for (int k = 0; k < count; ++k)
+            {
+                const float z = camera_points_(2, k);
+
+                // behind the camera or facing away from it
+                if (z <= 0.f ||
+                    camera_normals_.col(k).dot(camera_points_.col(k)) >= 0.f)
+                {
+                    continue;
+                }
+
+                const int pixel =
+                    camera_geometry_.project(camera_points_.col(k));
+                const float depth = pixel >= 0 ? image_[pixel] : NAN;
+
+                if (kinect_table_)
+                {
+                    loglike += std::isfinite(depth)
+                                   ? kinect_table_->loglike(z, depth)
+                                   : kinect_table_->occluded_loglike(z);
+                    continue;
+                }
+
+                if (!std::isfinite(depth))
+                {
+                    loglike += unobserved;
+                    continue;
+                }
+
+                // observations in front of the point may be occluders
+                const float residual = depth - z;
+                const float weight =
+                    residual < 0.f ? occlusion_weight : tail_weight;
+                loglike += std::log(
+                    std::exp(-0.5f * precision * residual * residual) +
+                    weight);
+            }
+            loglikes(i) += loglike;
+
+            if (!link_caches_.empty())
+            {
+                link_caches_[link].insert(rotation, translation, loglike);
+            }
+        }
+    }
+
+    return loglikes;
+}
+
+void SurfacePointSensor::update_link_poses(const StateArray& states)
+{
+    const int link_count = points_.size();
+    rotations_.resize(states.size() * link_count);
+    translations_.resize(states.size() * link_count);
+
+    // the kinematics are shared with the robot states
+    std::lock_guard<std::mutex> lock(*RobotState<>::kinematics_mutex_);
+    for (int i = 0; i < states.size(); ++i)
+    {
+        kinematics_->set_joint_angles(states(i));
+        for (int link = 0; link < link_count; ++link)
+        {
+            rotations_[i * link_count + link] =
+                kinematics_->get_link_orientation(link)
+                    .toRotationMatrix()
+                    .cast<float>();
+            translations_[i * link_count + link] =
+                kinematics_->get_link_position(link).cast<float>();
+        }
+    }
+}
+}
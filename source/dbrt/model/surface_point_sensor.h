@@ -0,0 +1,145 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file surface_point_sensor.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <dbot/model/rao_blackwell_sensor.h>
+#include <dbot/object_model.h>
+#include <dbrt/kinematics_from_urdf.h>
+#include <dbrt/model/kinect_pixel_model.h>
+#include <dbrt/model/link_score_cache.h>
+#include <dbrt/robot_state.h>
+#include <dbrt/util/camera_geometry.h>
+#include <memory>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Depth image sensor model scoring robot states by a fixed set of
+ *     surface points per link instead of rasterizing the meshes.
+ *
+ * The points are drawn once from the link meshes by area-weighted sampling.
+ * For each state they are transformed by the forward kinematics, points
+ * facing away from the camera are culled and the remaining points are
+ * projected to their pixel and compared to the observed depth. Hence the cost
+ * depends on neither the image resolution nor the triangle count.
+ *
+ * The states of a batch are transformed first and the points are then
+ * evaluated link by link for all states, such that the samples of a link stay
+ * in cache.
+ *
+ * Optionally, the points are scored by the tabulated Kinect pixel model
+ * instead of the Gaussian with outlier terms. Unobserved points are then
+ * scored like occluded points.
+ *
+ * Optionally, the contribution of each link is cached by the link pose for
+ * the current image. While a sampling block is evaluated, only the links
+ * moved by the block are scored, the others are looked up.
+ *
+ * The model has no per-particle state, hence the resampling indices are
+ * ignored.
+ */
+class SurfacePointSensor : public dbot::RbSensor<RobotState<>>
+{
+public:
+    typedef dbot::RbSensor<RobotState<>> Base;
+    typedef Base::State State;
+    typedef Base::StateArray StateArray;
+    typedef Base::RealArray RealArray;
+    typedef Base::IntArray IntArray;
+    typedef Base::Observation Observation;
+
+    struct Parameters
+    {
+        // surface samples per mesh link
+        int points_per_link;
+        // standard deviation of the observed depth in meters
+        double depth_sigma;
+        // weight of the uniform outlier term relative to the Gaussian peak
+        double tail_weight;
+        // weight of the outlier term for observations in front of the point,
+        // i.e. the point may be occluded. Unobserved points score the
+        // occluded term at a large residual.
+        double occlusion_weight;
+        // cached link poses per link and image, 0 disables the cache
+        int link_cache_size;
+    };
+
+public:
+    SurfacePointSensor(const std::shared_ptr<KinematicsFromURDF>& kinematics,
+                       const std::shared_ptr<dbot::ObjectModel>& object_model,
+                       const CameraGeometry& camera_geometry,
+                       const Parameters& parameters,
+                       const std::shared_ptr<const KinectLoglikeTable>&
+                           kinect_table = nullptr);
+
+    virtual RealArray loglikes(const StateArray& states,
+                               IntArray& indices,
+                               const bool& update = false);
+
+    virtual void set_observation(const Observation& image);
+
+    virtual void reset();
+
+    /**
+     * \brief Fraction of the link evaluations of the previous image which
+     *     were looked up in the link cache
+     */
+    double link_cache_hit_fraction() const { return link_cache_hit_fraction_; }
+
+private:
+    /**
+     * \brief Computes the link to camera transforms of all states
+     */
+    void update_link_poses(const StateArray& states);
+
+    /**
+     * \brief Clears the link caches and finishes the hit statistics of the
+     *     current image
+     */
+    void clear_link_caches();
+
+private:
+    std::shared_ptr<KinematicsFromURDF> kinematics_;
+    CameraGeometry camera_geometry_;
+    Parameters parameters_;
+    std::shared_ptr<const KinectLoglikeTable> kinect_table_;
+
+    // surface points and normals of each link in the link frame, one column
+    // per sample
+    std::vector<Eigen::Matrix3Xf> points_;
+    std::vector<Eigen::Matrix3Xf> normals_;
+
+    std::vector<float> image_;
+
+    // link poses of all states, state major
+    std::vector<Eigen::Matrix3f> rotations_;
+    std::vector<Eigen::Vector3f> translations_;
+
+    // samples of one link in the camera frame
+    Eigen::Matrix3Xf camera_points_;
+    Eigen::Matrix3Xf camera_normals_;
+
+    // contribution of each link by its pose for the current image
+    std::vector<LinkScoreCache> link_caches_;
+    long link_evaluations_;
+    long link_cache_hits_;
+    double link_cache_hit_fraction_;
+};
+}
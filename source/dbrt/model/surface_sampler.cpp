@@ -0,0 +1,91 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file surface_sampler.cpp
+ * \date October 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <dbrt/model/surface_sampler.h>
+
+namespace dbrt
+{
+SurfaceSamples sample_surface(const std::vector<Eigen::Vector3d>& vertices,
+                              const std::vector<std::vector<int>>& triangles,
+                              int count,
+                              std::mt19937& generator)
+{
+    SurfaceSamples samples;
+
+    // cumulative triangle areas. Searching the upper bound never selects
+    // triangles without area.
+    std::vector<double> cumulative_areas(triangles.size());
+    double area = 0.;
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        const Eigen::Vector3d& a = vertices[triangles[i][0]];
+        const Eigen::Vector3d& b = vertices[triangles[i][1]];
+        const Eigen::Vector3d& c = vertices[triangles[i][2]];
+        area += 0.5 * (b - a).cross(c - a).norm();
+        cumulative_areas[i] = area;
+    }
+
+    if (area <= 0.) return samples;
+
+    samples.points.reserve(count);
+    samples.normals.reserve(count);
+
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    for (int i = 0; i < count; ++i)
+    {
+        size_t t = std::upper_bound(cumulative_areas.begin(),
+                                    cumulative_areas.end(),
+                                    uniform(generator) * area) -
+                   cumulative_areas.begin();
+        t = std::min(t, triangles.size() - 1);
+
+        const Eigen::Vector3d& a = vertices[triangles[t][0]];
+        const Eigen::Vector3d& b = vertices[triangles[t][1]];
+        const Eigen::Vector3d& c = vertices[triangles[t][2]];
+
+        // uniform barycentric coordinates
+        double s = std::sqrt(uniform(generator));
+        double r = uniform(generator);
+        samples.points.push_back((1. - s) * a + s * (1. - r) * b + s * r * c);
+        samples.normals.push_back((b - a).cross(c - a).normalized());
+    }
+
+    return samples;
+}
+
+std::vector<SurfaceSamples> sample_surfaces(
+    const dbot::ObjectModel& object_model,
+    int count_per_part,
+    unsigned int seed)
+{
+    std::mt19937 generator(seed);
+
+    std::vector<SurfaceSamples> samples(object_model.vertices().size());
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        samples[i] = sample_surface(object_model.vertices()[i],
+                                    object_model.triangle_indices()[i],
+                                    count_per_part,
+                                    generator);
+    }
+
+    return samples;
+}
+}
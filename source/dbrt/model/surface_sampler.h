@@ -0,0 +1,56 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file surface_sampler.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Core>
+#include <dbot/object_model.h>
+#include <random>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Points on the surface of a mesh with their outward normals, both in
+ *     the mesh frame
+ */
+struct SurfaceSamples
+{
+    std::vector<Eigen::Vector3d> points;
+    std::vector<Eigen::Vector3d> normals;
+};
+
+/**
+ * \brief Draws count points uniformly distributed over the surface of the
+ *     given triangle mesh, i.e. triangles are chosen proportional to their
+ *     area. Normals follow from counter-clockwise triangle winding.
+ */
+SurfaceSamples sample_surface(const std::vector<Eigen::Vector3d>& vertices,
+                              const std::vector<std::vector<int>>& triangles,
+                              int count,
+                              std::mt19937& generator);
+
+/**
+ * \brief Samples the surface of each part of the object model. The samples
+ *     are deterministic for a given seed.
+ */
+std::vector<SurfaceSamples> sample_surfaces(
+    const dbot::ObjectModel& object_model,
+    int count_per_part,
+    unsigned int seed);
+}
@@ -0,0 +1,253 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file tile_raster_sensor.cpp
+ * \date October 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <dbrt/model/tile_raster_sensor.h>
+#include <limits>
+#include <mutex>
+
+namespace dbrt
+{
+TileRasterSensor::TileRasterSensor(
+    const std::shared_ptr<KinematicsFromURDF>& kinematics,
+    const std::shared_ptr<dbot::ObjectModel>& object_model,
+    const CameraGeometry& camera_geometry,
+    const Parameters& parameters,
+    const std::shared_ptr<const KinectLoglikeTable>& kinect_table)
+    : kinematics_(kinematics),
+      camera_geometry_(camera_geometry),
+      parameters_(parameters),
+      model_(parameters.kinect),
+      kinect_table_(kinect_table)
+{
+    // the object model has been loaded through the kinematics, i.e. its
+    // parts are ordered like the kinematics links
+    const int link_count =
+        std::min(object_model->count_parts(), kinematics->num_links());
+    link_offsets_.push_back(0);
+    for (int link = 0; link < link_count; ++link)
+    {
+        link_offsets_.push_back(link_offsets_.back() +
+                                object_model->vertices()[link].size());
+    }
+
+    vertices_.resize(3, link_offsets_.back());
+    for (int link = 0; link < link_count; ++link)
+    {
+        const auto& vertices = object_model->vertices()[link];
+        for (int i = 0; i < int(vertices.size()); ++i)
+        {
+            vertices_.col(link_offsets_[link] + i) =
+                vertices[i].cast<float>();
+        }
+
+        for (const auto& triangle : object_model->triangle_indices()[link])
+        {
+            triangles_.emplace_back(triangle[0] + link_offsets_[link],
+                                    triangle[1] + link_offsets_[link],
+                                    triangle[2] + link_offsets_[link]);
+        }
+    }
+
+    camera_vertices_.resize(3, vertices_.cols());
+    screen_triangles_.resize(triangles_.size());
+
+    const int tile_size = parameters_.tile_size;
+    tiles_x_ = (camera_geometry_.width() + tile_size - 1) / tile_size;
+    tiles_y_ = (camera_geometry_.height() + tile_size - 1) / tile_size;
+    bins_.resize(tiles_x_ * tiles_y_);
+    tile_depth_.resize(tile_size * tile_size);
+}
+
+void TileRasterSensor::set_observation(const Observation& image)
+{
+    image_.resize(image.size());
+    background_.resize(image.size());
+    for (int i = 0; i < image.size(); ++i)
+    {
+        image_[i] = image(i);
+
+        // no surface in front of the background
+        background_[i] =
+            std::isfinite(image_[i])
+                ? model_.loglike(std::numeric_limits<double>::infinity(),
+                                 image_[i])
+                : 0.f;
+    }
+}
+
+void TileRasterSensor::reset()
+{
+}
+
+auto TileRasterSensor::loglikes(const StateArray& states,
+                                IntArray& indices,
+                                const bool& update) -> RealArray
+{
+    update_link_poses(states);
+
+    RealArray loglikes = RealArray::Zero(states.size());
+    for (int i = 0; i < states.size(); ++i)
+    {
+        bin_triangles(i);
+
+        double loglike = 0.;
+        for (int tile = 0; tile < int(bins_.size()); ++tile)
+        {
+            if (!bins_[tile].empty()) loglike += score_tile(tile);
+        }
+        loglikes(i) = loglike;
+    }
+
+    return loglikes;
+}
+
+void TileRasterSensor::bin_triangles(int state)
+{
+    const int link_count = link_offsets_.size() - 1;
+    for (int link = 0; link < link_count; ++link)
+    {
+        const int offset = link_offsets_[link];
+        const int count = link_offsets_[link + 1] - offset;
+        if (count == 0) continue;
+
+        camera_vertices_.middleCols(offset, count).noalias() =
+            rotations_[state * link_count + link] *
+            vertices_.middleCols(offset, count);
+        camera_vertices_.middleCols(offset, count).colwise() +=
+            translations_[state * link_count + link];
+    }
+
+    // the bins keep their capacity, hence they stop allocating after the
+    // first states
+    for (auto& bin : bins_)
+    {
+        bin.clear();
+    }
+
+    const int tile_size = parameters_.tile_size;
+    const int width = camera_geometry_.width();
+    const int height = camera_geometry_.height();
+    for (size_t k = 0; k < triangles_.size(); ++k)
+    {
+        const Eigen::Vector3i& triangle = triangles_[k];
+        ScreenTriangle& t = screen_triangles_[k];
+        if (!project_triangle(camera_geometry_,
+                              camera_vertices_.col(triangle(0)),
+                              camera_vertices_.col(triangle(1)),
+                              camera_vertices_.col(triangle(2)),
+                              t))
+        {
+            continue;
+        }
+
+        // pixel centers within the bounding box
+        const int u_min = std::max(
+            int(std::ceil(std::min(t.u[0], std::min(t.u[1], t.u[2])))), 0);
+        const int u_max = std::min(
+            int(std::floor(std::max(t.u[0], std::max(t.u[1], t.u[2])))),
+            width - 1);
+        const int v_min = std::max(
+            int(std::ceil(std::min(t.v[0], std::min(t.v[1], t.v[2])))), 0);
+        const int v_max = std::min(
+            int(std::floor(std::max(t.v[0], std::max(t.v[1], t.v[2])))),
+            height - 1);
+        if (u_min > u_max || v_min > v_max) continue;
+
+        for (int ty = v_min / tile_size; ty <= v_max / tile_size; ++ty)
+        {
+            for (int tx = u_min / tile_size; tx <= u_max / tile_size; ++tx)
+            {
+                bins_[ty * tiles_x_ + tx].push_back(k);
+            }
+        }
+    }
+}
+
+double TileRasterSensor::score_tile(int tile)
+{
+    const int tile_size = parameters_.tile_size;
+    const int width = camera_geometry_.width();
+    PixelRoi region;
+    region.u_min = (tile % tiles_x_) * tile_size;
+    region.v_min = (tile / tiles_x_) * tile_size;
+    region.u_max = std::min(region.u_min + tile_size, width) - 1;
+    region.v_max =
+        std::min(region.v_min + tile_size, camera_geometry_.height()) - 1;
+
+    std::fill(tile_depth_.begin(),
+              tile_depth_.end(),
+              std::numeric_limits<float>::infinity());
+
+    for (int k : bins_[tile])
+    {
+        rasterize_triangle(
+            screen_triangles_[k], region, [&](int u, int v, float depth) {
+                float& z = tile_depth_[(v - region.v_min) * tile_size +
+                                       (u - region.u_min)];
+                z = std::min(z, depth);
+            });
+    }
+
+    double loglike = 0.;
+    for (int v = region.v_min; v <= region.v_max; ++v)
+    {
+        const float* depths = &tile_depth_[(v - region.v_min) * tile_size];
+        for (int u = region.u_min; u <= region.u_max; ++u)
+        {
+            const float predicted = depths[u - region.u_min];
+            const float observed = image_[v * width + u];
+            if (!std::isfinite(predicted) || !std::isfinite(observed))
+            {
+                continue;
+            }
+
+            const float pixel_loglike =
+                kinect_table_ ? kinect_table_->loglike(predicted, observed)
+                              : model_.loglike(predicted, observed);
+            loglike += pixel_loglike - background_[v * width + u];
+        }
+    }
+
+    return loglike;
+}
+
+void TileRasterSensor::update_link_poses(const StateArray& states)
+{
+    const int link_count = link_offsets_.size() - 1;
+    rotations_.resize(states.size() * link_count);
+    translations_.resize(states.size() * link_count);
+
+    // the kinematics are shared with the robot states
+    std::lock_guard<std::mutex> lock(*RobotState<>::kinematics_mutex_);
+    for (int i = 0; i < states.size(); ++i)
+    {
+        kinematics_->set_joint_angles(states(i));
+        for (int link = 0; link < link_count; ++link)
+        {
+            rotations_[i * link_count + link] =
+                kinematics_->get_link_orientation(link)
+                    .toRotationMatrix()
+                    .cast<float>();
+            translations_[i * link_count + link] =
+                kinematics_->get_link_position(link).cast<float>();
+        }
+    }
+}
+}
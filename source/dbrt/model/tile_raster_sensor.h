@@ -0,0 +1,130 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file tile_raster_sensor.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <dbot/model/rao_blackwell_sensor.h>
+#include <dbot/object_model.h>
+#include <dbrt/kinematics_from_urdf.h>
+#include <dbrt/model/kinect_pixel_model.h>
+#include <dbrt/robot_state.h>
+#include <dbrt/util/camera_geometry.h>
+#include <dbrt/util/rasterizer.h>
+#include <memory>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Kinect depth image sensor model which rasterizes the link meshes and
+ *     scores them tile by tile without full depth images.
+ *
+ * For each state the triangles of all links are projected and binned into
+ * square image tiles. Each tile touched by the robot is rasterized into a
+ * tile sized z-buffer and immediately scored against the observation, i.e.
+ * neither a depth image per state nor one per batch is ever written. The
+ * working set of a state is its projected triangles, the bins and a single
+ * tile.
+ *
+ * Pixels not covered by the robot show the background, whose likelihood is
+ * the same for all states. The log-likelihood of a state is therefore the sum
+ * over the covered pixels of the Kinect pixel log-likelihood minus that of
+ * the background. Occlusion is accounted for by the fixed occlusion
+ * probability of the pixel model, the model keeps no per-particle occlusion
+ * state and ignores the resampling indices.
+ */
+class TileRasterSensor : public dbot::RbSensor<RobotState<>>
+{
+public:
+    typedef dbot::RbSensor<RobotState<>> Base;
+    typedef Base::State State;
+    typedef Base::StateArray StateArray;
+    typedef Base::RealArray RealArray;
+    typedef Base::IntArray IntArray;
+    typedef Base::Observation Observation;
+
+    struct Parameters
+    {
+        // edge length of the square tiles in pixels
+        int tile_size;
+        KinectPixelModel::Parameters kinect;
+    };
+
+public:
+    TileRasterSensor(const std::shared_ptr<KinematicsFromURDF>& kinematics,
+                     const std::shared_ptr<dbot::ObjectModel>& object_model,
+                     const CameraGeometry& camera_geometry,
+                     const Parameters& parameters,
+                     const std::shared_ptr<const KinectLoglikeTable>&
+                         kinect_table = nullptr);
+
+    virtual RealArray loglikes(const StateArray& states,
+                               IntArray& indices,
+                               const bool& update = false);
+
+    virtual void set_observation(const Observation& image);
+
+    virtual void reset();
+
+private:
+    /**
+     * \brief Computes the link to camera transforms of all states
+     */
+    void update_link_poses(const StateArray& states);
+
+    /**
+     * \brief Projects and bins the triangles of the given state
+     */
+    void bin_triangles(int state);
+
+    /**
+     * \brief Rasterizes and scores the tile with the given index
+     */
+    double score_tile(int tile);
+
+private:
+    std::shared_ptr<KinematicsFromURDF> kinematics_;
+    CameraGeometry camera_geometry_;
+    Parameters parameters_;
+    KinectPixelModel model_;
+    std::shared_ptr<const KinectLoglikeTable> kinect_table_;
+
+    // vertices of all links in their link frames, the vertices of link l are
+    // the columns link_offsets_[l] to link_offsets_[l + 1] - 1
+    Eigen::Matrix3Xf vertices_;
+    std::vector<int> link_offsets_;
+    std::vector<Eigen::Vector3i> triangles_;
+
+    // link poses of all states, state major
+    std::vector<Eigen::Matrix3f> rotations_;
+    std::vector<Eigen::Vector3f> translations_;
+
+    // observed depth and background log-likelihood per pixel
+    std::vector<float> image_;
+    std::vector<float> background_;
+
+    // per state scratch: vertices in the camera frame, the projected
+    // triangles and the triangles overlapping each tile
+    Eigen::Matrix3Xf camera_vertices_;
+    std::vector<ScreenTriangle> screen_triangles_;
+    int tiles_x_;
+    int tiles_y_;
+    std::vector<std::vector<int>> bins_;
+    std::vector<float> tile_depth_;
+};
+}
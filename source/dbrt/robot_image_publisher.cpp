@@ -0,0 +1,126 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file robot_image_publisher.cpp
+ * \date October 2026
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <dbrt/robot_image_publisher.h>
+#include <sensor_msgs/image_encodings.h>
+
+namespace dbrt
+{
+RobotImagePublisher::RobotImagePublisher(
+    const std::shared_ptr<RobotRenderer>& renderer,
+    const std::string& prefix,
+    const std::string& frame_id,
+    bool publish_depth,
+    bool publish_mask,
+    bool publish_link_ids)
+    : node_handle_("~"),
+      renderer_(renderer),
+      publish_depth_(publish_depth),
+      publish_mask_(publish_mask),
+      publish_link_ids_(publish_link_ids)
+{
+    if (publish_depth_)
+    {
+        depth_publisher_ =
+            node_handle_.advertise<sensor_msgs::Image>(prefix + "/depth", 1);
+        init_image(sensor_msgs::image_encodings::TYPE_32FC1,
+                   sizeof(float),
+                   depth_image_);
+    }
+    if (publish_mask_)
+    {
+        mask_publisher_ = node_handle_.advertise<sensor_msgs::Image>(
+            prefix + "/robot_mask", 1);
+        init_image(sensor_msgs::image_encodings::MONO8,
+                   sizeof(std::uint8_t),
+                   mask_image_);
+    }
+    if (publish_link_ids_)
+    {
+        link_ids_publisher_ = node_handle_.advertise<sensor_msgs::Image>(
+            prefix + "/link_ids", 1);
+        init_image(sensor_msgs::image_encodings::TYPE_16UC1,
+                   sizeof(std::uint16_t),
+                   link_ids_image_);
+    }
+
+    depth_image_.header.frame_id = frame_id;
+    mask_image_.header.frame_id = frame_id;
+    link_ids_image_.header.frame_id = frame_id;
+}
+
+void RobotImagePublisher::init_image(const std::string& encoding,
+                                     int bytes_per_pixel,
+                                     sensor_msgs::Image& image) const
+{
+    const CameraGeometry& geometry = renderer_->camera_geometry();
+    image.encoding = encoding;
+    image.height = geometry.height();
+    image.width = geometry.width();
+    image.step = geometry.width() * bytes_per_pixel;
+    image.is_bigendian = 0;
+    image.data.resize(image.step * image.height);
+}
+
+void RobotImagePublisher::publish(const Eigen::VectorXd& state,
+                                  const ros::Time& time)
+{
+    const bool depth = publish_depth_ && depth_publisher_.getNumSubscribers();
+    const bool mask = publish_mask_ && mask_publisher_.getNumSubscribers();
+    const bool link_ids =
+        publish_link_ids_ && link_ids_publisher_.getNumSubscribers();
+    if (!depth && !mask && !link_ids) return;
+
+    renderer_->render(state);
+
+    if (depth)
+    {
+        std::memcpy(depth_image_.data.data(),
+                    renderer_->depth().data(),
+                    depth_image_.data.size());
+        depth_image_.header.stamp = time;
+        depth_publisher_.publish(depth_image_);
+    }
+
+    if (mask)
+    {
+        const Eigen::ArrayXi& ids = renderer_->link_ids();
+        for (int i = 0; i < ids.size(); ++i)
+        {
+            mask_image_.data[i] = ids(i) < 0 ? 0 : 255;
+        }
+        mask_image_.header.stamp = time;
+        mask_publisher_.publish(mask_image_);
+    }
+
+    if (link_ids)
+    {
+        const Eigen::ArrayXi& ids = renderer_->link_ids();
+        std::uint16_t* data =
+            reinterpret_cast<std::uint16_t*>(link_ids_image_.data.data());
+        for (int i = 0; i < ids.size(); ++i)
+        {
+            data[i] = std::uint16_t(ids(i) + 1);
+        }
+        link_ids_image_.header.stamp = time;
+        link_ids_publisher_.publish(link_ids_image_);
+    }
+}
+}
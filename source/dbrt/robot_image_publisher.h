@@ -0,0 +1,73 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file robot_image_publisher.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <dbrt/util/robot_renderer.h>
+#include <memory>
+#include <ros/ros.h>
+#include <sensor_msgs/Image.h>
+#include <string>
+
+namespace dbrt
+{
+/**
+ * \brief Publishes images of the robot rendered at the estimated state, e.g.
+ *     for removing the robot from point clouds.
+ *
+ * The enabled images are published on prefix + '/depth' (32FC1, meters, NaN
+ * where no link is visible), prefix + '/robot_mask' (mono8, 255 where a link
+ * is visible) and prefix + '/link_ids' (16UC1, link index + 1, 0 where no
+ * link is visible). All of them are obtained from a single rendering, which
+ * is skipped if none of the enabled images has a subscriber.
+ */
+class RobotImagePublisher
+{
+public:
+    RobotImagePublisher(const std::shared_ptr<RobotRenderer>& renderer,
+                        const std::string& prefix,
+                        const std::string& frame_id,
+                        bool publish_depth,
+                        bool publish_mask,
+                        bool publish_link_ids);
+
+    void publish(const Eigen::VectorXd& state, const ros::Time& time);
+
+private:
+    void init_image(const std::string& encoding,
+                    int bytes_per_pixel,
+                    sensor_msgs::Image& image) const;
+
+private:
+    ros::NodeHandle node_handle_;
+    std::shared_ptr<RobotRenderer> renderer_;
+
+    bool publish_depth_;
+    bool publish_mask_;
+    bool publish_link_ids_;
+    ros::Publisher depth_publisher_;
+    ros::Publisher mask_publisher_;
+    ros::Publisher link_ids_publisher_;
+
+    // messages are allocated once and refilled for every rendering
+    sensor_msgs::Image depth_image_;
+    sensor_msgs::Image mask_image_;
+    sensor_msgs::Image link_ids_image_;
+};
+}
@@ -27,6 +27,7 @@
 #include <dbot/rigid_body_renderer.h>
 #include <dbrt/kinematics_from_urdf.h>
 #include <dbrt/robot_transformer.h>
+#include <geometry_msgs/PoseArray.h>
 #include <image_transport/image_transport.h>
 #include <robot_state_publisher/robot_state_publisher.h>
 #include <ros/ros.h>
@@ -71,7 +72,23 @@ public:
      */
     void publish_joint_state(const State& state, const ros::Time time);
 
+    /**
+     * \brief publish the poses of all mesh links in the estimated camera
+     * frame to topic named prefix_ + '/link_poses', in kinematics link order.
+     * The link names are set once as parameter prefix_ + '/link_names'. The
+     * poses are only computed if there are subscribers, in the forward
+     * kinematics pass shared with publish_tf().
+     */
+    void publish_link_poses(const State& state, const ros::Time& time);
+
 protected:
+    /**
+     * \brief Computes the link poses and the estimated root transform of
+     * the given state in a single forward kinematics pass. Does nothing if
+     * they are up to date.
+     */
+    void update_estimate(const State& state);
+
     void publish_tf_tree(const State& state, const ros::Time& time);
 
     /**
@@ -82,8 +99,11 @@ protected:
                               const std::string& from,
                               const std::string& to);
 
+    /**
+     * \brief Transform between the measured and the estimated root, using
+     * the estimate of the last update_estimate()
+     */
     tf::StampedTransform get_root_transform(
-        const std::map<std::string, double>& estimated_joint_positions,
         const std::map<std::string, double>& observed_joint_positions,
         const ros::Time& time);
 
@@ -112,6 +132,16 @@ protected:
     sensor_msgs::JointState joint_state_msg_;
     ros::Publisher joint_state_publisher_;
 
+    // for publishing the link poses in the camera frame
+    std::shared_ptr<KinematicsFromURDF> kinematics_;
+    geometry_msgs::PoseArray link_poses_msg_;
+    ros::Publisher link_poses_publisher_;
+
+    // joint state of the last estimate and its transform target<-root,
+    // computed together with the link poses
+    Eigen::VectorXd estimate_;
+    tf::Transform estimated_target_root_;
+
     // These are needed for publishing a transform between the two roots
     // such that a connecting_frame_id is aligned in both.
     // \todo There is probably redundancy in all this publisher mess.
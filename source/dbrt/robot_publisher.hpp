@@ -23,9 +23,11 @@
 #include <dbrt/robot_publisher.h>
 
 #include <dbot_ros/util/ros_interface.h>
+#include <dbrt/robot_state.h>
 #include <dbrt/robot_transforms_provider.h>
 #include <fl/util/profiling.hpp>
 #include <fl/util/types.hpp>
+#include <mutex>
 #include <sensor_msgs/distortion_models.h>
 #include <sensor_msgs/fill_image.h>
 #include <tf/transform_broadcaster.h>
@@ -45,6 +47,7 @@ RobotPublisher<State>::RobotPublisher(
       transforms_provider_(std::make_shared<RobotTransformsProvider>(
           urdf_kinematics->get_tree())),
       joint_names_(urdf_kinematics->get_joint_map()),
+      kinematics_(urdf_kinematics),
       root_frame_name_(urdf_kinematics->get_root_frame_id()),
       connecting_frame_name_(connecting_frame_name),
       transformer_(transforms_provider_)
@@ -63,6 +66,21 @@ RobotPublisher<State>::RobotPublisher(
     // joint angle publisher
     joint_state_publisher_ = node_handle_.advertise<sensor_msgs::JointState>(
         prefix_ + "/joint_states", 0);
+
+    // link pose publisher. The names are static, hence not part of the
+    // message.
+    std::vector<std::string> link_names;
+    for (int i = 0; i < kinematics_->num_links(); ++i)
+    {
+        link_names.push_back(kinematics_->get_link_name(i));
+    }
+    node_handle_.setParam(prefix_ + "/link_names", link_names);
+
+    link_poses_msg_.header.frame_id =
+        tf::resolve(prefix_, kinematics_->camera_frame_id());
+    link_poses_msg_.poses.resize(link_names.size());
+    link_poses_publisher_ = node_handle_.advertise<geometry_msgs::PoseArray>(
+        prefix_ + "/link_poses", 0);
 }
 
 template <typename State>
@@ -81,6 +99,61 @@ void RobotPublisher<State>::publish_joint_state(const State& state,
     joint_state_publisher_.publish(joint_state_msg_);
 }
 
+template <typename State>
+void RobotPublisher<State>::publish_link_poses(const State& state,
+                                               const ros::Time& time)
+{
+    if (link_poses_publisher_.getNumSubscribers() == 0) return;
+
+    update_estimate(state);
+
+    link_poses_msg_.header.stamp = time;
+    link_poses_publisher_.publish(link_poses_msg_);
+}
+
+template <typename State>
+void RobotPublisher<State>::update_estimate(const State& state)
+{
+    // the TF and link pose outputs of the same estimate share this pass
+    if (estimate_.size() == state.size() &&
+        (estimate_.array() == state.array()).all())
+    {
+        return;
+    }
+    estimate_ = state;
+
+    // the kinematics are shared with the robot states
+    std::lock_guard<std::mutex> lock(*RobotState<>::kinematics_mutex_);
+    kinematics_->set_joint_angles(state);
+    for (int i = 0; i < int(link_poses_msg_.poses.size()); ++i)
+    {
+        const Eigen::VectorXd position = kinematics_->get_link_position(i);
+        const Eigen::Quaterniond orientation =
+            kinematics_->get_link_orientation(i);
+
+        geometry_msgs::Pose& pose = link_poses_msg_.poses[i];
+        pose.position.x = position(0);
+        pose.position.y = position(1);
+        pose.position.z = position(2);
+        pose.orientation.x = orientation.x();
+        pose.orientation.y = orientation.y();
+        pose.orientation.z = orientation.z();
+        pose.orientation.w = orientation.w();
+    }
+
+    // transform target<-root in the estimated tree
+    const KDL::Frame root_target =
+        kinematics_->get_frame_pose(connecting_frame_name_);
+    double x, y, z, w;
+    root_target.M.GetQuaternion(x, y, z, w);
+    estimated_target_root_ =
+        tf::Transform(tf::Quaternion(x, y, z, w),
+                      tf::Vector3(root_target.p.x(),
+                                  root_target.p.y(),
+                                  root_target.p.z()))
+            .inverse();
+}
+
 template <typename State>
 void RobotPublisher<State>::publish_tf(const State& state,
                                        const ros::Time& time)
@@ -110,16 +183,15 @@ void RobotPublisher<State>::publish_tf(const State& state,
                                        const JointsObsrv& obsrv,
                                        const ros::Time& time)
 {
-    std::map<std::string, double> estimated_joint_positions;
     std::map<std::string, double> observed_joint_positions;
-    state.GetJointState(estimated_joint_positions);
     to_joint_map(obsrv, observed_joint_positions);
 
     // Get the transform between the estimated root and measured root,
     // such that the estimated tree and measured tree are aligned
     // at the connecting frame
-    tf::StampedTransform root_transform = get_root_transform(
-        estimated_joint_positions, observed_joint_positions, time);
+    update_estimate(state);
+    tf::StampedTransform root_transform =
+        get_root_transform(observed_joint_positions, time);
 
     // Publish transform between roots
     static tf::TransformBroadcaster br;
@@ -157,16 +229,9 @@ void RobotPublisher<State>::publish_id_transform(const ros::Time& time,
 
 template <typename State>
 tf::StampedTransform RobotPublisher<State>::get_root_transform(
-    const std::map<std::string, double>& estimated_joint_positions,
     const std::map<std::string, double>& observed_joint_positions,
     const ros::Time& time)
 {
-    // Lookup transform target<-root in estimated tree
-    transformer_.set_joints(estimated_joint_positions);
-    tf::StampedTransform estimated_target_root;
-    transformer_.lookup_transform(
-        connecting_frame_name_, root_frame_name_, estimated_target_root);
-
     // Lookup transform root<-target in measured tree
     transformer_.set_joints(observed_joint_positions);
     tf::StampedTransform observed_root_target;
@@ -175,7 +240,7 @@ tf::StampedTransform RobotPublisher<State>::get_root_transform(
 
     // Compose the two transforms
     tf::StampedTransform transform_root_root(
-        observed_root_target * estimated_target_root,
+        observed_root_target * estimated_target_root_,
         time,
         tf::resolve("", root_frame_name_),
         tf::resolve(prefix_, root_frame_name_));
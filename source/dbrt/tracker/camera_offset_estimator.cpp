@@ -0,0 +1,155 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file camera_offset_estimator.cpp
+ * \date October 2026
+ */
+
+#include <dbrt/model/diagonal_transition.h>
+#include <dbrt/tracker/camera_offset_estimator.h>
+#include <ros/ros.h>
+
+namespace dbrt
+{
+CameraOffsetEstimator::CameraOffsetEstimator(
+    const VisualTrackerFactory& tracker_factory,
+    const std::vector<int>& offset_joints,
+    int frame_subsampling)
+    : tracker_factory_(tracker_factory),
+      offset_joints_(offset_joints),
+      frame_subsampling_(std::max(frame_subsampling, 1)),
+      frame_count_(0),
+      running_(false),
+      frame_pending_(false),
+      offset_mean_(Eigen::VectorXd::Zero(offset_joints.size())),
+      offset_variance_(Eigen::VectorXd::Zero(offset_joints.size()))
+{
+}
+
+void CameraOffsetEstimator::run()
+{
+    running_ = true;
+    estimator_thread_ =
+        std::thread(&CameraOffsetEstimator::run_estimator, this);
+}
+
+void CameraOffsetEstimator::shutdown()
+{
+    running_ = false;
+    estimator_thread_.join();
+}
+
+bool CameraOffsetEstimator::image_obsrv(const Obsrv& image,
+                                        const State& state)
+{
+    std::lock_guard<std::mutex> lock(frame_mutex_);
+
+    if (frame_pending_ || (frame_count_++ % frame_subsampling_) != 0)
+    {
+        return false;
+    }
+
+    pending_image_ = image;
+    pending_state_ = state;
+    frame_pending_ = true;
+
+    return true;
+}
+
+void CameraOffsetEstimator::apply_offset(State& state) const
+{
+    std::lock_guard<std::mutex> lock(offset_mutex_);
+
+    for (int i = 0; i < offset_joints_.size(); ++i)
+    {
+        state(offset_joints_[i], 0) = offset_mean_(i);
+    }
+}
+
+void CameraOffsetEstimator::apply_offset_covariance(
+    Eigen::MatrixXd& covariance) const
+{
+    std::lock_guard<std::mutex> lock(offset_mutex_);
+
+    for (int i = 0; i < offset_joints_.size(); ++i)
+    {
+        covariance(offset_joints_[i], offset_joints_[i]) = offset_variance_(i);
+    }
+}
+
+void CameraOffsetEstimator::run_estimator()
+{
+    auto tracker = tracker_factory_();
+
+    auto transition = std::static_pointer_cast<
+        DiagonalTransition<VisualTracker::State,
+                           VisualTracker::Noise,
+                           VisualTracker::Input>>(
+        tracker->filter()->transition());
+
+    // the configured offset noise is used as diffusion between two processed
+    // frames on top of the current offset uncertainty
+    const Eigen::VectorXd diffusion = transition->noise_diagonal();
+    Eigen::VectorXd noise_diagonal = diffusion;
+
+    State state;
+    Obsrv image;
+
+    ROS_INFO("Camera offset estimator running ...");
+
+    while (running_)
+    {
+        usleep(1000);
+        {
+            std::lock_guard<std::mutex> lock(frame_mutex_);
+            if (!frame_pending_) continue;
+
+            image.swap(pending_image_);
+            state = pending_state_;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(offset_mutex_);
+            for (int i = 0; i < offset_joints_.size(); ++i)
+            {
+                int k = offset_joints_[i];
+                state(k, 0) = offset_mean_(i);
+                noise_diagonal(k) = std::sqrt(offset_variance_(i) +
+                                              diffusion(k) * diffusion(k));
+            }
+        }
+
+        transition->noise_diagonal(noise_diagonal);
+        tracker->initialize({state});
+
+        State estimate = tracker->track(image);
+        auto cov = tracker->filter()->belief().covariance();
+
+        {
+            std::lock_guard<std::mutex> lock(offset_mutex_);
+            for (int i = 0; i < offset_joints_.size(); ++i)
+            {
+                int k = offset_joints_[i];
+                offset_mean_(i) = estimate(k, 0);
+                offset_variance_(i) = cov(k, k);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(frame_mutex_);
+            frame_pending_ = false;
+        }
+    }
+}
+}
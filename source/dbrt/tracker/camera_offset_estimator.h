@@ -0,0 +1,114 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file camera_offset_estimator.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <dbrt/tracker/visual_tracker.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Estimates the camera offset joints in a background thread at a
+ *     lower rate than the robot joints.
+ *
+ * The estimator receives a subsampled stream of depth images together with
+ * the robot state at the image time stamps. It runs a visual tracker which
+ * samples only the six camera offset joints while the robot joints are held
+ * fixed. The resulting Gaussian offset belief is handed to the main tracker
+ * via apply_offset() and apply_offset_covariance(), such that the main visual
+ * tracker does not need to sample the offset joints.
+ */
+class CameraOffsetEstimator
+{
+public:
+    typedef VisualTracker::State State;
+    typedef VisualTracker::Obsrv Obsrv;
+
+    typedef std::function<std::shared_ptr<VisualTracker>()>
+        VisualTrackerFactory;
+
+public:
+    /**
+     * \brief Creates the estimator
+     *
+     * \param tracker_factory
+     *     Creates the offset visual tracker. Called within the estimator
+     *     thread since the renderer may require a thread local context.
+     * \param offset_joints
+     *     State indices of the camera offset joints
+     * \param frame_subsampling
+     *     Only every frame_subsampling-th image is processed
+     */
+    CameraOffsetEstimator(const VisualTrackerFactory& tracker_factory,
+                          const std::vector<int>& offset_joints,
+                          int frame_subsampling);
+
+    void run();
+    void shutdown();
+
+    /**
+     * \brief Offers an image together with the robot state at the image time
+     *     stamp. The frame is accepted only if it is due according to the
+     *     frame subsampling and the estimator is idle.
+     *
+     * \return true if the frame has been accepted
+     */
+    bool image_obsrv(const Obsrv& image, const State& state);
+
+    /**
+     * \brief Overwrites the offset joints of the given state with the current
+     *     offset estimate
+     */
+    void apply_offset(State& state) const;
+
+    /**
+     * \brief Overwrites the diagonal entries of the offset joints in the
+     *     given covariance with the current offset variances
+     */
+    void apply_offset_covariance(Eigen::MatrixXd& covariance) const;
+
+    const std::vector<int>& offset_joints() const { return offset_joints_; }
+
+protected:
+    void run_estimator();
+
+private:
+    VisualTrackerFactory tracker_factory_;
+    std::vector<int> offset_joints_;
+    int frame_subsampling_;
+    int frame_count_;
+
+    bool running_;
+    bool frame_pending_;
+    Obsrv pending_image_;
+    State pending_state_;
+
+    Eigen::VectorXd offset_mean_;
+    Eigen::VectorXd offset_variance_;
+
+    mutable std::mutex frame_mutex_;
+    mutable std::mutex offset_mutex_;
+    std::thread estimator_thread_;
+};
+}
@@ -0,0 +1,54 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file depth_tracker.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <dbrt/tracker/robot_tracker.h>
+
+namespace dbrt
+{
+/**
+ * \brief Tracker correcting a prior joint belief based on a depth image.
+ *     Interface of the visual backends used by the FusionTracker.
+ */
+class DepthTracker : public RobotTracker
+{
+public:
+    /**
+     * \brief Sets the prior of the next track() call
+     *
+     * \param mean
+     *     Predicted joint state
+     * \param std_diagonal
+     *     Standard deviation of each joint. Joints with zero standard
+     *     deviation are kept fixed.
+     * \param effort
+     *     Fraction in (0, 1] of the nominal computation, e.g. likelihood
+     *     evaluations or iterations, spent on the next image
+     */
+    virtual void set_prior(const State& mean,
+                           const Eigen::VectorXd& std_diagonal,
+                           double effort) = 0;
+
+    /**
+     * \brief Covariance of the estimate returned by the latest track() call
+     */
+    virtual Eigen::MatrixXd covariance() = 0;
+};
+}
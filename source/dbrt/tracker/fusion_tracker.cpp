@@ -17,10 +17,11 @@
  * \author Jan Issac (jan.issac@gmail.com)
  */
 
-#include <dbot_ros/util/ros_interface.h>
+#include <cassert>
+#include <chrono>
 #include <dbrt/tracker/fusion_tracker.h>
+#include <dbrt/util/allocation_counter.h>
 #include <ros/ros.h>
-#include <sensor_msgs/JointState.h>
 
 namespace dbrt
 {
@@ -29,15 +30,27 @@ FusionTracker::FusionTracker(
     const std::shared_ptr<KinematicsFromURDF>& kinematics,
     const RotaryTrackerFactory& rotary_tracker_factory,
     const VisualTrackerFactory& visual_tracker_factory,
-    double camera_delay)
+    double camera_delay,
+    const BufferParameters& buffer_parameters,
+    const LatencyParameters& latency_parameters,
+    const std::shared_ptr<CameraOffsetEstimator>& camera_offset_estimator)
     : camera_data_(camera_data),
       kinematics_(kinematics),
       visual_tracker_factory_(visual_tracker_factory),
+      camera_offset_estimator_(camera_offset_estimator),
       running_(true),
       camera_delay_(camera_delay),
-      ros_image_updated_(false)
+      buffer_parameters_(buffer_parameters),
+      latency_parameters_(latency_parameters),
+      latency_metrics_(),
+      consecutive_skipped_frames_(0),
+      rotary_time_(0.),
+      rotary_allocations_(0),
+      image_time_(0.),
+      image_updated_(false)
 {
     gaussian_joint_tracker_ = rotary_tracker_factory();
+    refilter_tracker_ = rotary_tracker_factory();
     i_t = 0;
     j_t = 0;
 }
@@ -46,80 +59,407 @@ void FusionTracker::initialize(const std::vector<State>& initial_states)
 {
     current_state_ = initial_states[0];
     gaussian_joint_tracker_->initialize(initial_states);
+
+    rotary_state_ = current_state_;
+    rotary_angle_measurement_ = JointsObsrv::Zero(kinematics_->num_joints());
+    state_at_entry_.joints_obsrv_entry.obsrv =
+        JointsObsrv::Zero(kinematics_->num_joints());
+    state_at_entry_.beliefs = gaussian_joint_tracker_->beliefs();
+
+    allocate_buffers();
 }
 
-void FusionTracker::run_rotary_tracker()
+void FusionTracker::allocate_buffers()
 {
-    ROS_INFO("Rotary tracker running ...");
+    const int joint_count = kinematics_->num_joints();
+
+    JointsObsrvEntry obsrv_prototype;
+    obsrv_prototype.timestamp = 0.;
+    obsrv_prototype.obsrv = JointsObsrv::Zero(joint_count);
+
+    JointsHistoryEntry history_prototype;
+    history_prototype.joints_obsrv_entry = obsrv_prototype;
+    history_prototype.belief_slot = -1;
+
+    const std::vector<JointBelief>& beliefs_prototype =
+        gaussian_joint_tracker_->beliefs();
+    covariance_diagonal_ = Eigen::VectorXd::Zero(beliefs_prototype.size());
+
+    const std::size_t obsrv_bytes =
+        sizeof(JointsObsrvEntry) + joint_count * sizeof(fl::Real);
+    const std::size_t history_bytes =
+        sizeof(JointsHistoryEntry) + joint_count * sizeof(fl::Real);
+    const std::size_t beliefs_bytes =
+        sizeof(std::vector<JointBelief>) + joint_count * sizeof(JointBelief);
+
+    // unprocessed and processed observations are double buffered and get a
+    // quarter of the budget each, belief snapshots get the remaining half.
+    // With a tiered history most processed observations carry no snapshot,
+    // so processed observations get half and snapshots a quarter instead.
+    //
+    // After a visual update both history buffers are replayed into the
+    // unprocessed observations. Each history slot is therefore paid together
+    // with a reserved slot in both unprocessed buffers, such that replayed
+    // observations are never discarded.
+    const std::size_t budget = buffer_parameters_.memory_budget;
+    const bool tiered = buffer_parameters_.full_rate_window >= 0.;
+    const std::size_t history_budget = tiered ? budget / 4 : budget / 8;
+    const std::size_t belief_budget = tiered ? budget / 4 : budget / 2;
+    const int obsrv_capacity = std::max<int>(budget / 8 / obsrv_bytes, 2);
+    const int history_capacity = std::max<int>(
+        history_budget / (history_bytes + 2 * obsrv_bytes), 2);
+    const int belief_capacity = std::max<int>(belief_budget / beliefs_bytes, 2);
+
+    joints_obsrv_capacity_ = obsrv_capacity;
+    joints_obsrv_new_count_ = 0;
+    joints_obsrvs_buffer_.allocate(obsrv_capacity + 2 * history_capacity,
+                                   obsrv_prototype);
+    joints_obsrvs_buffer_local_.allocate(obsrv_capacity + 2 * history_capacity,
+                                         obsrv_prototype);
+    joints_obsrv_belief_buffer_.allocate(history_capacity, history_prototype);
+    joints_obsrv_belief_buffer_local_.allocate(history_capacity,
+                                               history_prototype);
+    belief_pool_.allocate(belief_capacity, beliefs_prototype);
+    reset_history_tiers();
+
+    image_ = ImageObsrv::Zero(camera_data_->resolution().width *
+                              camera_data_->resolution().height);
+
+    ROS_INFO_STREAM("Fusion buffers allocated for a memory budget of "
+                    << budget / (1024. * 1024.)
+                    << " MB: "
+                    << obsrv_capacity
+                    << " joint observations, "
+                    << history_capacity
+                    << " processed observations, "
+                    << belief_capacity
+                    << " belief snapshots.");
+}
 
-    while (running_)
+void FusionTracker::push_history_entry(
+    const JointsObsrvEntry& joints_obsrv_entry,
+    const std::vector<JointBelief>& beliefs)
+{
+    if (joints_obsrv_belief_buffer_.full() || belief_pool_.available() == 0)
     {
-        usleep(10);
-        std::deque<JointsObsrvEntry> joints_obsrvs_buffer_local;
+        handle_history_overflow(joints_obsrv_belief_buffer_);
+    }
+
+    int belief_slot = belief_pool_.acquire();
+    if (belief_slot >= 0)
+    {
+        belief_pool_[belief_slot] = beliefs;
+    }
+
+    JointsHistoryEntry& entry = joints_obsrv_belief_buffer_.push_back();
+    entry.joints_obsrv_entry = joints_obsrv_entry;
+    entry.belief_slot = belief_slot;
+
+    compress_history_tail(joints_obsrv_belief_buffer_);
+}
+
+void FusionTracker::compress_history_tail(JointsHistoryBuffer& history)
+{
+    if (buffer_parameters_.full_rate_window < 0. || history.empty()) return;
+
+    const double window_begin = history.back().joints_obsrv_entry.timestamp -
+                                buffer_parameters_.full_rate_window;
+
+    // entries leave the window in order, hence each entry is visited once
+    for (; history_tail_size_ < history.size(); ++history_tail_size_)
+    {
+        JointsHistoryEntry& entry = history[history_tail_size_];
+        if (entry.joints_obsrv_entry.timestamp >= window_begin) break;
+        if (entry.belief_slot < 0) continue;
+
+        if (history_last_checkpoint_ < 0 ||
+            history_tail_size_ - history_last_checkpoint_ >=
+                buffer_parameters_.checkpoint_stride)
         {
-            std::lock_guard<std::mutex> lock(joints_obsrv_buffer_mutex_);
-            if (joints_obsrvs_buffer_.size() == 0) continue;
-            joints_obsrvs_buffer_.swap(joints_obsrvs_buffer_local);
+            history_last_checkpoint_ = history_tail_size_;
+            continue;
         }
 
-        State current_state;
-        double current_time;
-        JointsObsrv current_angle_measurement;
+        belief_pool_.release(entry.belief_slot);
+        entry.belief_slot = -1;
+    }
+}
+
+void FusionTracker::pop_front_history_entry(JointsHistoryBuffer& history)
+{
+    belief_pool_.release(history.front().belief_slot);
+    history.pop_front();
+
+    history_tail_size_ = std::max(history_tail_size_ - 1, 0);
+    history_last_checkpoint_ = std::max(history_last_checkpoint_ - 1, -1);
+}
+
+void FusionTracker::reset_history_tiers()
+{
+    // checkpoints are spaced by index, rescanning the tail keeps them
+    history_tail_size_ = 0;
+    history_last_checkpoint_ = -1;
+}
+
+void FusionTracker::push_front_joints_obsrv(
+    const JointsObsrvEntry& joints_obsrv_entry)
+{
+    // the replay reserve covers both history buffers, see allocate_buffers()
+    assert(!joints_obsrvs_buffer_.full());
+    if (joints_obsrvs_buffer_.full())
+    {
+        ROS_ERROR_THROTTLE(1.0,
+                           "Joint observation replay reserve exhausted. "
+                           "Discarding a replayed joint observation.");
+        return;
+    }
+
+    joints_obsrvs_buffer_.push_front(joints_obsrv_entry);
+}
+
+void FusionTracker::handle_obsrv_buffer_overflow(JointsObsrvBuffer& buffer)
+{
+    ROS_WARN_STREAM_THROTTLE(
+        1.0,
+        "Joint angle max buffer size ("
+            << joints_obsrv_capacity_
+            << ") "
+            << "reached! This means most likely that no image "
+            << "has been received in a while. Old joint angles "
+            << "can only be discarded once an image with a later "
+            << "time stamp is received.");
+
+    // replayed observations precede the new ones and are kept
+    const int first_new = buffer.size() - joints_obsrv_new_count_;
+    switch (buffer_parameters_.overflow_policy)
+    {
+        case OverflowPolicy::DropOldest:
+            joints_obsrv_new_count_ -=
+                buffer.remove_if([&](int i) { return i == first_new; });
+            break;
+        case OverflowPolicy::Decimate:
+        case OverflowPolicy::Compress:
         {
-            std::lock_guard<std::mutex> state_lock(current_state_mutex_);
-            current_state = current_state_;
-            current_time = current_time_;
-            current_angle_measurement = current_angle_measurement_;
+            const int older_half = joints_obsrv_new_count_ / 2;
+            const int removed = buffer.remove_if([&](int i) {
+                return i >= first_new && i - first_new < older_half &&
+                       (i - first_new) % 2 == 1;
+            });
+            // too few observations to decimate
+            if (removed == 0)
+            {
+                buffer.remove_if([&](int i) { return i == first_new; });
+                joints_obsrv_new_count_ -= 1;
+            }
+            joints_obsrv_new_count_ -= removed;
+            break;
         }
+    }
+}
 
-        std::lock_guard<std::mutex> belief_buffer_lock(
-            joints_obsrv_belief_buffer_mutex_);
-        for (auto joints_obsrv_entry : joints_obsrvs_buffer_local)
+void FusionTracker::handle_history_overflow(JointsHistoryBuffer& history)
+{
+    ROS_WARN_THROTTLE(1.0,
+                      "Belief buffer max size reached. It seems the visual "
+                      "tracker is too slow.");
+
+    const int older_half = history.size() / 2;
+
+    switch (buffer_parameters_.overflow_policy)
+    {
+        case OverflowPolicy::DropOldest:
+            break;
+        case OverflowPolicy::Decimate:
+        {
+            auto decimated = [&](int i) {
+                return i < older_half && i % 2 == 1;
+            };
+            for (int i = 0; i < history.size(); ++i)
+            {
+                if (decimated(i)) belief_pool_.release(history[i].belief_slot);
+            }
+            history.remove_if(decimated);
+            reset_history_tiers();
+            break;
+        }
+        case OverflowPolicy::Compress:
         {
-            // construct a joints belief entry which contains the following
-            //  - the joints measurement values
-            //  - their time stamp
-            //  - the updated joints belief
-            JointsBeliefEntry joints_belief_entry;
-            joints_belief_entry.joints_obsrv_entry = joints_obsrv_entry;
-
-            current_state = gaussian_joint_tracker_->track(
-                joints_belief_entry.joints_obsrv_entry.obsrv);
-            current_time = joints_belief_entry.joints_obsrv_entry.timestamp;
-            current_angle_measurement =
-                joints_belief_entry.joints_obsrv_entry.obsrv;
-
-            joints_belief_entry.beliefs = gaussian_joint_tracker_->beliefs();
-
-            // update sliding window of belief and joints obsrv entries
-            joints_obsrv_belief_buffer_.push_back(joints_belief_entry);
-            if (joints_obsrv_belief_buffer_.size() > 10000)
+            if (history.full()) break;
+
+            // keep every checkpoint_stride-th remaining snapshot of the older
+            // half. Repeated compression thins out older history further.
+            int snapshots = 0;
+            for (int i = 0; i < older_half; ++i)
             {
-                ROS_WARN(
-                    "Belief buffer max size reached ... discarding oldest "
-                    "belief. It seems the visual tracker is too slow.");
-                joints_obsrv_belief_buffer_.pop_front();
+                if (history[i].belief_slot < 0) continue;
+                if (snapshots++ % buffer_parameters_.checkpoint_stride == 0)
+                {
+                    continue;
+                }
+                belief_pool_.release(history[i].belief_slot);
+                history[i].belief_slot = -1;
             }
+            reset_history_tiers();
+            break;
         }
+    }
 
+    // fall back to dropping the oldest entries if the policy could not free
+    // any space
+    while (!history.empty() &&
+           (history.full() || belief_pool_.available() == 0))
+    {
+        pop_front_history_entry(history);
+    }
+}
+
+void FusionTracker::run_rotary_tracker()
+{
+    apply_thread_config("dbrt_rotary", rotary_thread_config_);
+
+    // batches which may still allocate, e.g. on first use of lazily
+    // initialized storage
+    const int warm_up_batches = 100;
+    int batch_count = 0;
+
+    ROS_INFO("Rotary tracker running ...");
+
+    while (running_)
+    {
+        usleep(10);
+        const std::uint64_t allocations = thread_allocation_count();
+        if (!process_joints_obsrvs()) continue;
+
+        // steady state allocations are counted only if built with
+        // DBRT_COUNT_ALLOCATIONS
+        if (++batch_count > warm_up_batches &&
+            thread_allocation_count() != allocations)
+        {
+            rotary_allocations_ += thread_allocation_count() - allocations;
+            ROS_ERROR_THROTTLE(1,
+                               "Rotary tracker allocated on the heap. %lu "
+                               "allocations after warm-up so far.",
+                               (unsigned long)rotary_allocations_.load());
+        }
+    }
+}
+
+bool FusionTracker::process_joints_obsrvs()
+{
+    // the rotary state and measurement are allocated on initialization and
+    // only assigned to afterwards
+    State& current_state = rotary_state_;
+    JointsObsrv& current_angle_measurement = rotary_angle_measurement_;
+    double current_time;
+
+    {
+        std::lock_guard<std::mutex> lock(joints_obsrv_buffer_mutex_);
+        if (joints_obsrvs_buffer_.size() == 0) return false;
+        joints_obsrvs_buffer_.swap(joints_obsrvs_buffer_local_);
+        joints_obsrv_new_count_ = 0;
+    }
+
+    {
+        std::lock_guard<std::mutex> state_lock(current_state_mutex_);
+        current_state = current_state_;
+        current_time = current_time_;
+        current_angle_measurement = current_angle_measurement_;
+    }
+
+    std::lock_guard<std::mutex> belief_buffer_lock(
+        joints_obsrv_belief_buffer_mutex_);
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < joints_obsrvs_buffer_local_.size(); ++i)
+    {
+        const JointsObsrvEntry& joints_obsrv_entry =
+            joints_obsrvs_buffer_local_[i];
+
+        gaussian_joint_tracker_->track(joints_obsrv_entry.obsrv, current_state);
+        current_time = joints_obsrv_entry.timestamp;
+        current_angle_measurement = joints_obsrv_entry.obsrv;
+
+        // update sliding window of processed joint obsrv entries and
+        // their beliefs
+        push_history_entry(joints_obsrv_entry,
+                           gaussian_joint_tracker_->beliefs());
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // moving average of the time per joint observation, used to predict
+    // the replay time of visual corrections
+    double step_time = std::chrono::duration<double>(end - begin).count() /
+                       joints_obsrvs_buffer_local_.size();
+    rotary_time_ =
+        rotary_time_ > 0. ? 0.9 * rotary_time_ + 0.1 * step_time : step_time;
+    joints_obsrvs_buffer_local_.clear();
+
+    {
+        std::lock_guard<std::mutex> state_lock(current_state_mutex_);
+        current_state_ = current_state;
+        current_time_ = current_time;
+        current_angle_measurement_ = current_angle_measurement;
+    }
+
+    if (estimate_callback_)
+    {
+        const std::vector<JointBelief>& beliefs =
+            gaussian_joint_tracker_->beliefs();
+        for (int i = 0; i < covariance_diagonal_.size(); ++i)
         {
-            std::lock_guard<std::mutex> state_lock(current_state_mutex_);
-            current_state_ = current_state;
-            current_time_ = current_time;
-            current_angle_measurement_ = current_angle_measurement;
+            covariance_diagonal_(i) = beliefs[i].covariance()(0, 0);
         }
+        estimate_callback_(current_time, current_state, covariance_diagonal_);
     }
+
+    return true;
+}
+
+bool FusionTracker::state_at(double timestamp, State& state)
+{
+    std::lock_guard<std::mutex> belief_buffer_lock(
+        joints_obsrv_belief_buffer_mutex_);
+
+    if (find_belief_entry(
+            joints_obsrv_belief_buffer_, timestamp, state_at_entry_) < 0)
+    {
+        return false;
+    }
+
+    get_state_from_belief(state_at_entry_, state);
+    return true;
 }
 
 void FusionTracker::run_visual_tracker()
 {
-    std::shared_ptr<VisualTracker> particle_tracker = visual_tracker_factory_();
+    apply_thread_config("dbrt_visual", visual_thread_config_);
+
+    std::shared_ptr<DepthTracker> visual_tracker = visual_tracker_factory_();
 
     State current_state;
     double garbage;
 
     current_state_and_time(current_state, garbage);
-    particle_tracker->initialize({current_state});
+    visual_tracker->initialize({current_state});
+
+    // square root of the diagonal rotary belief covariance. allocated once
+    // and reused in every step
+    Eigen::VectorXd cov_sqrt_diagonal(current_state.size());
+
+    // local copy of the latest image
+    ImageObsrv image = ImageObsrv::Zero(camera_data_->resolution().width *
+                                        camera_data_->resolution().height);
+
+    // mean of the rotary belief at the image time stamp
+    State mean = current_state;
+
+    // image regions of the links kept by the background model
+    std::vector<PixelRoi> background_rois(kinematics_->num_links());
+
+    // belief entry of the current image time stamp
+    JointsBeliefEntry belief_entry;
+    belief_entry.joints_obsrv_entry.obsrv =
+        JointsObsrv::Zero(current_state.size());
+    belief_entry.beliefs = gaussian_joint_tracker_->beliefs();
 
     ROS_INFO("Visual tracker running ...");
 
@@ -127,22 +467,25 @@ void FusionTracker::run_visual_tracker()
     {
         // continue only if there is a new image available
         usleep(100);
+        double image_time;
         {
             std::lock_guard<std::mutex> lock(image_obsrvs_mutex_);
-            if (!ros_image_updated_)
+            if (!image_updated_)
             {
                 continue;
             }
+            image_time = image_time_;
         }
 
         /**
          * #1 SWAP ROTARY BELIEF QUEUES SECURLY
-         * #2 GET ROTARY BELIEF AND ITS INDEX FOR IMAGE TIMESTAMP
+         * #2 GET ROTARY BELIEF AND ITS INDEX FOR IMAGE TIMESTAMP AND
+         *    SKIP IMAGE IF IT CANNOT BE PROCESSED WITHIN LATENCY BUDGET
          * #3 CONSTRUCT STATE AND NOISE MATRIX FROM ROTARY BELIEF
-         * #4 GET PROCESS MODEL
-         * #5 SET PROCESS MODEL NOISE COVARIANCE
-         * #6 INITIALIZE PARTICLE FILTER WITH ROTARY STATE
-         * #7 TRACK AND GET STATE AND COVARIANCE
+         * #4 SKIP IMAGE IF NEITHER THE ROBOT NOR THE IMAGE HAVE CHANGED
+         * #5 SET PRIOR NOISE DIAGONAL OF THE VISUAL TRACKER
+         * #6 INITIALIZE VISUAL TRACKER WITH ROTARY STATE
+         * #7 MASK STATIC BACKGROUND, TRACK AND GET STATE AND COVARIANCE
          * #8 CONSTRUCT NEW ANGEL BELIEFS
          * #9 SET ROTARY ANGEL BELIEFS
          * #10 FILL BUFFER WITH OLD JOINT OBSRV
@@ -150,67 +493,134 @@ void FusionTracker::run_visual_tracker()
 
         INIT_PROFILING;
 
-        JointsBeliefEntry belief_entry;
         int belief_index;
+        double rotary_time;
 
         // #1
-        std::deque<JointsBeliefEntry> joints_obsrv_belief_buffer_local;
         {
             std::lock_guard<std::mutex> belief_buffer_lock(
                 joints_obsrv_belief_buffer_mutex_);
 
-            joints_obsrv_belief_buffer_.swap(joints_obsrv_belief_buffer_local);
+            joints_obsrv_belief_buffer_.swap(joints_obsrv_belief_buffer_local_);
+            reset_history_tiers();
+            rotary_time = rotary_time_;
         }
 
         // #2
-        belief_index = find_belief_entry(joints_obsrv_belief_buffer_local,
-                                         ros_image_.header.stamp.toSec(),
-                                         belief_entry);
+        belief_index = find_belief_entry(
+            joints_obsrv_belief_buffer_local_, image_time, belief_entry);
         if (belief_index < 0)
         {
             // no belief found, put back extracted beliefs from local to global
             // buffer
-            std::lock_guard<std::mutex> belief_buffer_lock(
-                joints_obsrv_belief_buffer_mutex_);
-            while (joints_obsrv_belief_buffer_local.size() > 0)
+            restore_history();
+            continue;
+        }
+
+        FrameDecision decision = decide_frame(joints_obsrv_belief_buffer_local_,
+                                              belief_index,
+                                              image_time,
+                                              rotary_time);
+        if (decision == FrameDecision::Skipped)
+        {
             {
-                joints_obsrv_belief_buffer_.push_front(
-                    joints_obsrv_belief_buffer_local.back());
-                joints_obsrv_belief_buffer_local.pop_back();
+                // keep the image if a newer one arrived in the meantime
+                std::lock_guard<std::mutex> lock(image_obsrvs_mutex_);
+                if (image_time_ == image_time)
+                {
+                    image_updated_ = false;
+                }
             }
+            restore_history();
             continue;
         }
 
         // #3
-        auto mean = get_state_from_belief(belief_entry);
-        auto cov_sqrt = get_covariance_sqrt_from_belief(belief_entry);
+        get_state_from_belief(belief_entry, mean);
+        get_covariance_sqrt_diagonal_from_belief(belief_entry,
+                                                 cov_sqrt_diagonal);
+
+        if (camera_offset_estimator_)
+        {
+            // offset joints are estimated by the decoupled estimator and
+            // remain fixed within the visual tracker
+            camera_offset_estimator_->apply_offset(mean);
+            for (int k : camera_offset_estimator_->offset_joints())
+            {
+                cov_sqrt_diagonal(k) = 0.;
+            }
+        }
 
         // #4
-        auto transition = std::static_pointer_cast<
-            fl::LinearTransition<VisualTracker::State,
-                                 VisualTracker::Noise,
-                                 VisualTracker::Input>>(
-            particle_tracker->filter()->transition());
+        bool image_taken = false;
+        if (motion_gate_)
+        {
+            {
+                std::lock_guard<std::mutex> lock(image_obsrvs_mutex_);
+                image.swap(image_);
+                image_updated_ = false;
+            }
+            image_taken = true;
 
-        // #5
-        transition->noise_matrix(cov_sqrt);
+            const bool open = motion_gate_->check(image_time, mean, image);
+            {
+                std::lock_guard<std::mutex> lock(latency_metrics_mutex_);
+                latency_metrics_.motion_gate = motion_gate_->metrics();
+            }
+            if (!open)
+            {
+                ROS_DEBUG_THROTTLE(
+                    10.0,
+                    "Robot stationary, %d images gated, update interval %f s",
+                    motion_gate_->metrics().gated_frames,
+                    motion_gate_->metrics().interval);
+                restore_history();
+                continue;
+            }
+        }
 
-        // #6
-        particle_tracker->initialize({mean});
+        // #5 & #6
+        auto begin = std::chrono::steady_clock::now();
+        visual_tracker->set_prior(
+            mean,
+            cov_sqrt_diagonal,
+            decision == FrameDecision::Processed
+                ? 1.
+                : latency_parameters_.reduced_sample_fraction);
 
         // #7
-        sensor_msgs::Image ros_image;
+        if (!image_taken)
         {
+            // the ingest buffer and the local buffer have the same size,
+            // swapping them neither copies nor allocates
             std::lock_guard<std::mutex> lock(image_obsrvs_mutex_);
-            ros_image = ros_image_;
-            ros_image_updated_ = false;
+            image.swap(image_);
+            image_updated_ = false;
+        }
+
+        if (motion_gate_)
+        {
+            // the prior mean is the reference for the joint displacement.
+            // The reference image must not be masked.
+            motion_gate_->processed(image_time, mean, image);
+        }
+
+        if (background_model_)
+        {
+            mask_background(mean, image, background_rois);
         }
 
-        auto image = ri::to_eigen_vector<double>(
-            ros_image, camera_data_->downsampling_factor());
         State current_state;
-        current_state = particle_tracker->track(image);
-        auto cov = particle_tracker->filter()->belief().covariance();
+        current_state = visual_tracker->track(image);
+        Eigen::MatrixXd cov = visual_tracker->covariance();
+        auto end = std::chrono::steady_clock::now();
+
+        if (camera_offset_estimator_)
+        {
+            camera_offset_estimator_->image_obsrv(image, current_state);
+            camera_offset_estimator_->apply_offset(current_state);
+            camera_offset_estimator_->apply_offset_covariance(cov);
+        }
 
         // #8
         auto angle_beliefs = get_angel_beliefs_from_moments(current_state, cov);
@@ -225,47 +635,260 @@ void FusionTracker::run_visual_tracker()
 
         while (joints_obsrv_belief_buffer_.size() > 0)
         {
-            joints_obsrvs_buffer_.push_front(
+            push_front_joints_obsrv(
                 joints_obsrv_belief_buffer_.back().joints_obsrv_entry);
+            belief_pool_.release(
+                joints_obsrv_belief_buffer_.back().belief_slot);
             joints_obsrv_belief_buffer_.pop_back();
         }
+        reset_history_tiers();
 
         // throw away obsrv prior to belief index
         for (int i = 0; i < belief_index; ++i)
         {
-            joints_obsrv_belief_buffer_local.pop_front();
+            belief_pool_.release(
+                joints_obsrv_belief_buffer_local_.front().belief_slot);
+            joints_obsrv_belief_buffer_local_.pop_front();
         }
 
         // add back joint observations after belief index
-        while (joints_obsrv_belief_buffer_local.size() > 0)
+        while (joints_obsrv_belief_buffer_local_.size() > 0)
         {
-            joints_obsrvs_buffer_.push_front(
-                joints_obsrv_belief_buffer_local.back().joints_obsrv_entry);
-            joints_obsrv_belief_buffer_local.pop_back();
+            push_front_joints_obsrv(
+                joints_obsrv_belief_buffer_local_.back().joints_obsrv_entry);
+            belief_pool_.release(
+                joints_obsrv_belief_buffer_local_.back().belief_slot);
+            joints_obsrv_belief_buffer_local_.pop_back();
         }
 
+        update_latency_metrics(
+            decision, std::chrono::duration<double>(end - begin).count());
+
         // MEASURE("total time for visual processing");
     }
 }
 
-int FusionTracker::find_belief_entry(const std::deque<JointsBeliefEntry>& queue,
+void FusionTracker::mask_background(const State& mean,
+                                    ImageObsrv& image,
+                                    std::vector<PixelRoi>& rois)
+{
+    const CameraGeometry& geometry = *background_geometry_;
+    link_rois(*kinematics_,
+              geometry,
+              mean,
+              background_parameters_.link_radius,
+              rois);
+
+    bool robot_in_view = false;
+    for (const PixelRoi& roi : rois)
+    {
+        robot_in_view = robot_in_view || !roi.empty();
+    }
+
+    int masked_pixels = 0;
+    if (robot_in_view)
+    {
+        masked_pixels = background_model_->mask(rois, image);
+    }
+    else if (background_parameters_.learn)
+    {
+        // the whole image shows the background
+        background_model_->learn(image);
+
+        if (!background_parameters_.capture_file.empty() &&
+            background_model_->learned_images() ==
+                background_parameters_.capture_images)
+        {
+            if (background_model_->write(background_parameters_.capture_file))
+            {
+                ROS_INFO("Captured background model to %s",
+                         background_parameters_.capture_file.c_str());
+            }
+            else
+            {
+                ROS_WARN("Failed to write background model %s",
+                         background_parameters_.capture_file.c_str());
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(latency_metrics_mutex_);
+    latency_metrics_.masked_pixels = masked_pixels;
+}
+
+void FusionTracker::restore_history()
+{
+    std::lock_guard<std::mutex> belief_buffer_lock(
+        joints_obsrv_belief_buffer_mutex_);
+    while (joints_obsrv_belief_buffer_local_.size() > 0)
+    {
+        if (joints_obsrv_belief_buffer_.full())
+        {
+            // no space left for older entries
+            belief_pool_.release(
+                joints_obsrv_belief_buffer_local_.back().belief_slot);
+        }
+        else
+        {
+            joints_obsrv_belief_buffer_.push_front(
+                joints_obsrv_belief_buffer_local_.back());
+        }
+        joints_obsrv_belief_buffer_local_.pop_back();
+    }
+    reset_history_tiers();
+}
+
+auto FusionTracker::decide_frame(const JointsHistoryBuffer& history,
+                                 int belief_index,
+                                 double image_time,
+                                 double rotary_time) -> FrameDecision
+{
+    std::lock_guard<std::mutex> lock(latency_metrics_mutex_);
+    LatencyMetrics& metrics = latency_metrics_;
+
+    const double latest_time = history.back().joints_obsrv_entry.timestamp;
+    const double span =
+        latest_time - history.front().joints_obsrv_entry.timestamp;
+    const double joint_rate = span > 0. ? (history.size() - 1) / span : 0.;
+
+    metrics.frame_age = std::max(latest_time - image_time, 0.);
+    metrics.replay_count = history.size() - belief_index;
+    metrics.rotary_time = rotary_time;
+
+    // joint observations arriving while the image is being processed have to
+    // be replayed as well
+    auto predict_latency = [&](double visual_time) {
+        double replay_count = metrics.replay_count + joint_rate * visual_time;
+        return metrics.frame_age + visual_time + replay_count * rotary_time;
+    };
+    double visual_time_reduced =
+        metrics.visual_time_reduced > 0.
+            ? metrics.visual_time_reduced
+            : metrics.visual_time * latency_parameters_.reduced_sample_fraction;
+    metrics.predicted_latency = predict_latency(metrics.visual_time);
+    metrics.predicted_latency_reduced = predict_latency(visual_time_reduced);
+
+    const double budget = latency_parameters_.budget;
+    if (budget < 0. || metrics.predicted_latency <= budget)
+    {
+        metrics.decision = FrameDecision::Processed;
+    }
+    else if (metrics.predicted_latency_reduced <= budget ||
+             consecutive_skipped_frames_ >=
+                 latency_parameters_.max_skipped_frames)
+    {
+        metrics.decision = FrameDecision::ProcessedReduced;
+    }
+    else
+    {
+        metrics.decision = FrameDecision::Skipped;
+    }
+
+    if (metrics.decision == FrameDecision::Skipped)
+    {
+        metrics.skipped_frames++;
+        consecutive_skipped_frames_++;
+
+        ROS_WARN_STREAM_THROTTLE(1.0,
+                                 "Skipping image with predicted latency of "
+                                     << metrics.predicted_latency_reduced
+                                     << " s exceeding the latency budget of "
+                                     << budget
+                                     << " s (frame age: "
+                                     << metrics.frame_age
+                                     << " s, replay: "
+                                     << metrics.replay_count
+                                     << " joint observations)");
+    }
+    else
+    {
+        consecutive_skipped_frames_ = 0;
+    }
+
+    return metrics.decision;
+}
+
+void FusionTracker::update_latency_metrics(FrameDecision decision,
+                                           double visual_time)
+{
+    std::lock_guard<std::mutex> lock(latency_metrics_mutex_);
+    LatencyMetrics& metrics = latency_metrics_;
+
+    double& average = decision == FrameDecision::Processed
+                          ? metrics.visual_time
+                          : metrics.visual_time_reduced;
+    average = average > 0. ? 0.9 * average + 0.1 * visual_time : visual_time;
+
+    metrics.latency = metrics.frame_age + visual_time +
+                      metrics.replay_count * metrics.rotary_time;
+    metrics.processed_frames++;
+    if (decision == FrameDecision::ProcessedReduced) metrics.reduced_frames++;
+
+    if (latency_parameters_.budget >= 0.)
+    {
+        ROS_INFO_STREAM_THROTTLE(10.0,
+                                 "Visual tracker latency: "
+                                     << metrics.latency
+                                     << " s (budget "
+                                     << latency_parameters_.budget
+                                     << " s), images processed: "
+                                     << metrics.processed_frames
+                                     << ", with reduced particles: "
+                                     << metrics.reduced_frames
+                                     << ", skipped: "
+                                     << metrics.skipped_frames);
+    }
+}
+
+int FusionTracker::find_belief_entry(const JointsHistoryBuffer& history,
                                      double timestamp,
                                      JointsBeliefEntry& belief_entry)
 {
-    int index = 0;
-    double min = std::numeric_limits<double>::max();
-    double max = std::numeric_limits<double>::min();
-    for (const auto entry : queue)
+    for (int index = 0; index < history.size(); ++index)
     {
-        min = std::min(min, entry.joints_obsrv_entry.timestamp);
-        max = std::max(max, entry.joints_obsrv_entry.timestamp);
+        if (history[index].joints_obsrv_entry.timestamp <= timestamp)
+        {
+            continue;
+        }
+
+        belief_entry.joints_obsrv_entry = history[index].joints_obsrv_entry;
+
+        if (history[index].belief_slot >= 0)
+        {
+            belief_entry.beliefs = belief_pool_[history[index].belief_slot];
+            return index;
+        }
+
+        // the snapshot has been compressed away. re-filter the raw joint
+        // observations starting at the closest preceding checkpoint.
+        int checkpoint = index - 1;
+        while (checkpoint >= 0 && history[checkpoint].belief_slot < 0)
+        {
+            --checkpoint;
+        }
 
-        if (entry.joints_obsrv_entry.timestamp > timestamp)
+        if (checkpoint >= 0)
         {
-            belief_entry = entry;
+            refilter_tracker_->set_beliefs(
+                belief_pool_[history[checkpoint].belief_slot]);
+            for (int i = checkpoint + 1; i <= index; ++i)
+            {
+                refilter_tracker_->track(history[i].joints_obsrv_entry.obsrv);
+            }
+            belief_entry.beliefs = refilter_tracker_->beliefs();
             return index;
         }
-        index++;
+
+        // no checkpoint before the time stamp left, use the closest one after
+        for (int i = index + 1; i < history.size(); ++i)
+        {
+            if (history[i].belief_slot < 0) continue;
+
+            belief_entry.joints_obsrv_entry = history[i].joints_obsrv_entry;
+            belief_entry.beliefs = belief_pool_[history[i].belief_slot];
+            return i;
+        }
+        return -1;
     }
 
     // debugging information
@@ -299,36 +922,34 @@ int FusionTracker::find_belief_entry(const std::deque<JointsBeliefEntry>& queue,
     return -1;
 }
 
-auto FusionTracker::get_state_from_belief(const JointsBeliefEntry& entry)
-    -> State
+void FusionTracker::get_state_from_belief(const JointsBeliefEntry& entry,
+                                          State& state)
 {
-    State state;
-    state.resize(entry.beliefs.size());
+    if (state.size() != entry.beliefs.size())
+    {
+        state.resize(entry.beliefs.size());
+    }
+
     for (int i = 0; i < state.size(); ++i)
     {
         state(i, 0) = entry.beliefs[i].mean()(0, 0);
     }
-
-    return state;
 }
 
-Eigen::MatrixXd FusionTracker::get_covariance_sqrt_from_belief(
-    const FusionTracker::JointsBeliefEntry& entry)
+void FusionTracker::get_covariance_sqrt_diagonal_from_belief(
+    const FusionTracker::JointsBeliefEntry& entry,
+    Eigen::VectorXd& cov_sqrt_diagonal)
 {
-    Eigen::MatrixXd cov_sqrt;
-    cov_sqrt.setZero(entry.beliefs.size(), entry.beliefs.size());
-
     if (entry.beliefs.size() == 0)
     {
         throw std::runtime_error("Something is wrong. The beliefs are empty.");
     }
 
-    for (int i = 0; i < cov_sqrt.rows(); ++i)
+    cov_sqrt_diagonal.resize(entry.beliefs.size());
+    for (int i = 0; i < cov_sqrt_diagonal.size(); ++i)
     {
-        cov_sqrt(i, i) = std::sqrt(entry.beliefs[i].covariance()(0, 0));
+        cov_sqrt_diagonal(i) = std::sqrt(entry.beliefs[i].covariance()(0, 0));
     }
-
-    return cov_sqrt;
 }
 
 std::vector<RotaryTracker::AngleBelief>
@@ -359,6 +980,8 @@ void FusionTracker::run()
         std::thread(&FusionTracker::run_rotary_tracker, this);
     particle_tracker_thread_ =
         std::thread(&FusionTracker::run_visual_tracker, this);
+
+    if (camera_offset_estimator_) camera_offset_estimator_->run();
 }
 
 void FusionTracker::shutdown()
@@ -366,6 +989,34 @@ void FusionTracker::shutdown()
     running_ = false;
     gaussian_tracker_thread_.join();
     particle_tracker_thread_.join();
+
+    if (camera_offset_estimator_) camera_offset_estimator_->shutdown();
+}
+
+void FusionTracker::estimate_callback(const EstimateCallback& callback)
+{
+    estimate_callback_ = callback;
+}
+
+void FusionTracker::thread_configs(const ThreadConfig& rotary_thread_config,
+                                   const ThreadConfig& visual_thread_config)
+{
+    rotary_thread_config_ = rotary_thread_config;
+    visual_thread_config_ = visual_thread_config;
+}
+
+void FusionTracker::motion_gate(const std::shared_ptr<MotionGate>& motion_gate)
+{
+    motion_gate_ = motion_gate;
+}
+
+void FusionTracker::background_model(
+    const std::shared_ptr<BackgroundModel>& background_model,
+    const BackgroundParameters& parameters)
+{
+    background_model_ = background_model;
+    background_parameters_ = parameters;
+    background_geometry_ = std::make_shared<CameraGeometry>(*camera_data_);
 }
 
 void FusionTracker::current_state_and_time(State& current_state,
@@ -388,28 +1039,34 @@ void FusionTracker::current_things(State& current_state,
     current_angle_measurement = current_angle_measurement_;
 }
 
-void FusionTracker::joints_obsrv_callback(
-    const sensor_msgs::JointState& joint_msg)
+std::uint64_t FusionTracker::rotary_allocation_count() const
 {
-    std::lock_guard<std::mutex> lock(joints_obsrv_buffer_mutex_);
+    return rotary_allocations_;
+}
 
-    JointsObsrvEntry entry;
-    entry.timestamp = joint_msg.header.stamp.toSec();
-    entry.obsrv = kinematics_->sensor_msg_to_eigen(joint_msg);
-    joints_obsrvs_buffer_.push_back(entry);
+auto FusionTracker::latency_metrics() const -> LatencyMetrics
+{
+    std::lock_guard<std::mutex> lock(latency_metrics_mutex_);
+    return latency_metrics_;
+}
 
-    if (joints_obsrvs_buffer_.size() > 1000000)
+void FusionTracker::joints_obsrv(
+    double timestamp,
+    const Eigen::Ref<const JointsObsrv>& joint_values)
+{
+    std::lock_guard<std::mutex> lock(joints_obsrv_buffer_mutex_);
+
+    // new observations may not use the slots reserved for replays
+    if (joints_obsrv_new_count_ >= joints_obsrv_capacity_)
     {
-        ROS_WARN_STREAM("Joint angle max buffer size ("
-                        << 1000000
-                        << ") "
-                        << "reached! This means most likely that no image "
-                        << "has been received in a while. Old joint angles "
-                        << "can only be discarded once an image with a later "
-                        << "time stamp is received.");
-        joints_obsrvs_buffer_.pop_front();
+        handle_obsrv_buffer_overflow(joints_obsrvs_buffer_);
     }
 
+    JointsObsrvEntry& entry = joints_obsrvs_buffer_.push_back();
+    ++joints_obsrv_new_count_;
+    entry.timestamp = timestamp;
+    entry.obsrv = joint_values;
+
     if (j_t > entry.timestamp)
     {
         ROS_WARN_STREAM("Joint angle measurements not ordered! This means "
@@ -422,18 +1079,17 @@ void FusionTracker::joints_obsrv_callback(
     j_t = entry.timestamp;
 }
 
-void FusionTracker::image_obsrv_callback(const sensor_msgs::Image& ros_image)
+void FusionTracker::image_obsrv(const DepthImageView& image)
 {
     std::lock_guard<std::mutex> lock(image_obsrvs_mutex_);
 
-    ros_image_updated_ = true;
-    ros_image_ = ros_image;
-    ros_image_.header.stamp.fromSec(ros_image_.header.stamp.toSec() -
-                                    camera_delay_);
+    depth_image_to_obsrv(image, camera_data_->downsampling_factor(), image_);
+    image_time_ = image.timestamp - camera_delay_;
+    image_updated_ = true;
 
     std::lock_guard<std::mutex> lock_joint_obsrv(joints_obsrv_buffer_mutex_);
 
-    if (i_t > ros_image_.header.stamp.toSec())
+    if (i_t > image_time_)
     {
         ROS_WARN_STREAM("Image measurements not ordered! This means that an "
                         << "image was received with an older time stamp than "
@@ -441,7 +1097,7 @@ void FusionTracker::image_obsrv_callback(const sensor_msgs::Image& ros_image)
                         << "never occurr and is not handled!");
     }
 
-    i_t = ros_image_.header.stamp.toSec();
+    i_t = image_time_;
 
     if (i_t > j_t)
     {
@@ -19,10 +19,21 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <dbrt/model/diagonal_transition.h>
+#include <dbrt/tracker/camera_offset_estimator.h>
+#include <dbrt/tracker/depth_tracker.h>
+#include <dbrt/tracker/motion_gate.h>
 #include <dbrt/tracker/robot_tracker.h>
 #include <dbrt/tracker/rotary_tracker.h>
 #include <dbrt/tracker/visual_tracker.h>
-#include <deque>
+#include <dbrt/util/background_model.h>
+#include <dbrt/util/camera_geometry.h>
+#include <dbrt/util/depth_image.h>
+#include <dbrt/util/ring_buffer.h>
+#include <dbrt/util/robot_roi.h>
+#include <dbrt/util/thread_config.h>
 #include <fl/filter/gaussian/gaussian_filter_linear.hpp>
 #include <fl/model/sensor/linear_gaussian_sensor.hpp>
 #include <fl/model/transition/interface/transition_function.hpp>
@@ -31,6 +42,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -50,12 +62,24 @@ public:
     // single joint observation space
     typedef RotaryTracker::JointObsrv JointObsrv;
 
-    typedef std::function<std::shared_ptr<VisualTracker>()>
+    // depth image observation space
+    typedef VisualTracker::Obsrv ImageObsrv;
+
+    typedef std::function<std::shared_ptr<DepthTracker>()>
         VisualTrackerFactory;
 
     typedef std::function<std::shared_ptr<RotaryTracker>()>
         RotaryTrackerFactory;
 
+    /**
+     * \brief Receives each estimate of the rotary tracker, i.e. the time
+     *     stamp, the joint state and the diagonal of the joint covariance
+     */
+    typedef std::function<void(double timestamp,
+                               const State& state,
+                               const Eigen::VectorXd& covariance_diagonal)>
+        EstimateCallback;
+
     struct JointsObsrvEntry
     {
         double timestamp;
@@ -68,12 +92,128 @@ public:
         std::vector<JointBelief> beliefs;
     };
 
+    /**
+     * \brief Processed joint observation within the belief history. The
+     *     belief snapshot after processing the observation is stored in the
+     *     belief pool slot belief_slot, or has been discarded if it is -1.
+     */
+    struct JointsHistoryEntry
+    {
+        JointsObsrvEntry joints_obsrv_entry;
+        int belief_slot;
+    };
+
+    typedef RingBuffer<JointsObsrvEntry> JointsObsrvBuffer;
+    typedef RingBuffer<JointsHistoryEntry> JointsHistoryBuffer;
+    typedef SlotPool<std::vector<JointBelief>> BeliefPool;
+
+    /**
+     * \brief Defines what happens once a buffer has reached its capacity
+     */
+    enum class OverflowPolicy
+    {
+        // discard the oldest entry
+        DropOldest,
+        // discard every second entry of the older half
+        Decimate,
+        // discard the belief snapshots of the older half except for every
+        // checkpoint_stride-th one while keeping all joint observations.
+        // Behaves like Decimate for the unprocessed observation buffer.
+        Compress
+    };
+
+    struct BufferParameters
+    {
+        // memory for joint observation and belief storage in bytes. All
+        // storage is preallocated from this budget on initialization.
+        std::size_t memory_budget;
+        OverflowPolicy overflow_policy;
+        int checkpoint_stride;
+        // duration in seconds of the recent history which keeps a belief
+        // snapshot for every joint observation. Older history only keeps
+        // every checkpoint_stride-th snapshot and re-filters the raw joint
+        // observations from the closest checkpoint on demand. A negative
+        // value keeps all snapshots.
+        double full_rate_window;
+    };
+
+    struct LatencyParameters
+    {
+        // maximum latency in seconds between an image time stamp and the
+        // replayed correction being available in the rotary tracker. Images
+        // which cannot be processed within the budget are processed with
+        // fewer particles or skipped. A negative value processes all images.
+        double budget;
+        // fraction of the particle count used for late images
+        double reduced_sample_fraction;
+        // number of consecutive skipped images after which an image is
+        // processed with the reduced particle count regardless of the budget
+        int max_skipped_frames;
+    };
+
+    /**
+     * \brief Outcome of the latency budget check of an image
+     */
+    enum class FrameDecision
+    {
+        Processed,
+        ProcessedReduced,
+        Skipped
+    };
+
+    /**
+     * \brief Inputs and outcome of the latest frame skipping decision. All
+     *     times in seconds.
+     */
+    struct LatencyMetrics
+    {
+        FrameDecision decision;
+        // age of the image relative to the latest processed joint obsrv
+        double frame_age;
+        // processed joint observations to replay after the correction
+        int replay_count;
+        // moving averages of the visual update with full and reduced
+        // particle count, and of a single rotary update
+        double visual_time;
+        double visual_time_reduced;
+        double rotary_time;
+        // predicted latency including the replay for both particle counts
+        double predicted_latency;
+        double predicted_latency_reduced;
+        // latency of the latest correction, including the predicted replay
+        double latency;
+        int processed_frames;
+        int reduced_frames;
+        int skipped_frames;
+        // state of the motion gate, if enabled
+        MotionGate::Metrics motion_gate;
+        // pixels of the latest image invalidated by the background model
+        int masked_pixels;
+    };
+
+    struct BackgroundParameters
+    {
+        // radius of the spheres around the link origins in meters. Pixels
+        // within their image regions are never masked.
+        double link_radius;
+        // whether images in which the robot is out of view are learned
+        bool learn;
+        // file the model is written to once capture_images images have been
+        // learned. Nothing is written if empty.
+        std::string capture_file;
+        int capture_images;
+    };
+
 public:
     FusionTracker(const std::shared_ptr<dbot::CameraData>& camera_data,
                   const std::shared_ptr<KinematicsFromURDF>& kinematics,
                   const RotaryTrackerFactory& rotary_tracker_factory,
                   const VisualTrackerFactory& visual_tracker_factory,
-                  double camera_delay);
+                  double camera_delay,
+                  const BufferParameters& buffer_parameters,
+                  const LatencyParameters& latency_parameters,
+                  const std::shared_ptr<CameraOffsetEstimator>&
+                      camera_offset_estimator = nullptr);
 
     /**
      * \brief Initializes the filters with the given initial states and
@@ -84,8 +224,74 @@ public:
     void run();
     void shutdown();
 
-    void joints_obsrv_callback(const sensor_msgs::JointState& joints_obsrv);
-    void image_obsrv_callback(const sensor_msgs::Image& ros_image);
+    /**
+     * \brief Processes the pending joint observations in the calling thread
+     *     and appends them to the history. Called by the rotary tracker
+     *     thread after run(). May be driven directly without run(), e.g. by
+     *     benchmarks. Does not allocate after warm-up.
+     *
+     * \return false if no joint observations were pending
+     */
+    bool process_joints_obsrvs();
+
+    /**
+     * \brief Writes the mean of the rotary belief of the first processed
+     *     joint observation after the given time stamp, as used for the
+     *     visual update of an image with that time stamp. Does not allocate.
+     *
+     * \return false if no such observation is in the history
+     */
+    bool state_at(double timestamp, State& state);
+
+    /**
+     * \brief Adds a joint measurement. Does not allocate.
+     *
+     * \param timestamp
+     *     Measurement time stamp in seconds
+     * \param joint_values
+     *     Joint values in model order, see KinematicsFromURDF::get_joint_map()
+     */
+    void joints_obsrv(double timestamp,
+                      const Eigen::Ref<const JointsObsrv>& joint_values);
+
+    /**
+     * \brief Sets the latest depth image. The image is converted into a
+     *     preallocated buffer and is not referenced after returning.
+     */
+    void image_obsrv(const DepthImageView& image);
+
+    /**
+     * \brief Sets a callback which is invoked from the rotary tracker thread
+     *     after each batch of processed joint observations. Must be set
+     *     before run().
+     */
+    void estimate_callback(const EstimateCallback& callback);
+
+    /**
+     * \brief Sets the CPU affinity and scheduling of the rotary and visual
+     *     tracker threads. Applied when the threads start, i.e. must be set
+     *     before run().
+     */
+    void thread_configs(const ThreadConfig& rotary_thread_config,
+                        const ThreadConfig& visual_thread_config);
+
+    /**
+     * \brief Sets a gate which skips images while the robot is stationary.
+     *     Used by the visual tracker thread only, i.e. must be set before
+     *     run().
+     */
+    void motion_gate(const std::shared_ptr<MotionGate>& motion_gate);
+
+    /**
+     * \brief Sets a static background model. Pixels which match the
+     *     background outside of the robot region are invalidated before the
+     *     visual update. Only neutral for visual trackers which skip invalid
+     *     pixels, i.e. the SDF sensor and the registration tracker. Must be
+     *     set before run().
+     */
+    void background_model(
+        const std::shared_ptr<BackgroundModel>& background_model,
+        const BackgroundParameters& parameters);
 
     void current_state_and_time(State& current_state,
                                 double& current_time) const;
@@ -93,17 +299,100 @@ public:
                         double& current_time,
                         JointsObsrv& current_angle_measurement) const;
 
+    /**
+     * \brief Returns the metrics of the latest frame skipping decision
+     */
+    LatencyMetrics latency_metrics() const;
+
+    /**
+     * \brief Returns the number of heap allocations of the rotary tracker
+     *     thread after warm-up. Always 0 unless built with
+     *     DBRT_COUNT_ALLOCATIONS.
+     */
+    std::uint64_t rotary_allocation_count() const;
+
 protected:
     void run_rotary_tracker();
     void run_visual_tracker();
 
 private:
-    int find_belief_entry(const std::deque<JointsBeliefEntry>& queue,
+    /**
+     * \brief Preallocates the observation buffers and the belief pool from
+     *     the memory budget
+     */
+    void allocate_buffers();
+
+    /**
+     * \brief Appends a processed observation and a snapshot of the given
+     *     beliefs to the history. Applies the overflow policy if required.
+     */
+    void push_history_entry(const JointsObsrvEntry& joints_obsrv_entry,
+                            const std::vector<JointBelief>& beliefs);
+
+    /**
+     * \brief Prepends a replayed observation to the unprocessed
+     *     observations. Uses the slots reserved for replays. These suffice
+     *     by construction, an exhausted reserve is reported nonetheless.
+     */
+    void push_front_joints_obsrv(const JointsObsrvEntry& joints_obsrv_entry);
+
+    void handle_obsrv_buffer_overflow(JointsObsrvBuffer& buffer);
+    void handle_history_overflow(JointsHistoryBuffer& history);
+
+    /**
+     * \brief Discards the belief snapshots of history entries which have
+     *     left the full rate window, except for periodic checkpoints
+     */
+    void compress_history_tail(JointsHistoryBuffer& history);
+
+    /**
+     * \brief Removes the oldest history entry and releases its snapshot
+     */
+    void pop_front_history_entry(JointsHistoryBuffer& history);
+
+    /**
+     * \brief Restarts the checkpoint bookkeeping of the history. Required
+     *     whenever entries have been inserted or removed other than at the
+     *     ends of the history.
+     */
+    void reset_history_tiers();
+
+    /**
+     * \brief Invalidates the background pixels outside of the link regions
+     *     at the given mean, or learns the image if the robot is out of view
+     */
+    void mask_background(const State& mean,
+                         ImageObsrv& image,
+                         std::vector<PixelRoi>& rois);
+
+    /**
+     * \brief Moves the history taken by the visual tracker back in front of
+     *     the history processed in the meantime
+     */
+    void restore_history();
+
+    /**
+     * \brief Decides whether the image at the given time stamp is processed
+     *     with full or reduced particle count or skipped in order to meet
+     *     the latency budget
+     */
+    FrameDecision decide_frame(const JointsHistoryBuffer& history,
+                               int belief_index,
+                               double image_time,
+                               double rotary_time);
+
+    /**
+     * \brief Updates the timing statistics after a processed image
+     */
+    void update_latency_metrics(FrameDecision decision, double visual_time);
+
+    int find_belief_entry(const JointsHistoryBuffer& history,
                           double timestamp,
                           JointsBeliefEntry& belief_entry);
-    State get_state_from_belief(const JointsBeliefEntry& entry);
-    Eigen::MatrixXd get_covariance_sqrt_from_belief(
-        const JointsBeliefEntry& entry);
+    void get_state_from_belief(const JointsBeliefEntry& entry, State& state);
+    void get_covariance_sqrt_diagonal_from_belief(
+        const JointsBeliefEntry& entry,
+        Eigen::VectorXd& cov_sqrt_diagonal);
 
     std::vector<RotaryTracker::AngleBelief> get_angel_beliefs_from_moments(
         const State& mean,
@@ -117,9 +406,28 @@ private:
     std::shared_ptr<dbot::CameraData> camera_data_;
     std::shared_ptr<KinematicsFromURDF> kinematics_;
     std::shared_ptr<RotaryTracker> gaussian_joint_tracker_;
+    // scratch tracker re-filtering joint observations from a checkpoint
+    std::shared_ptr<RotaryTracker> refilter_tracker_;
+    // optional decoupled estimator of the camera offset joints
+    std::shared_ptr<CameraOffsetEstimator> camera_offset_estimator_;
+    // optional gate skipping images while the robot is stationary
+    std::shared_ptr<MotionGate> motion_gate_;
+    // optional static background model and the image geometry it is
+    // applied with
+    std::shared_ptr<BackgroundModel> background_model_;
+    std::shared_ptr<CameraGeometry> background_geometry_;
+    BackgroundParameters background_parameters_;
 
     bool running_;
     double camera_delay_;
+    BufferParameters buffer_parameters_;
+    LatencyParameters latency_parameters_;
+    LatencyMetrics latency_metrics_;
+    int consecutive_skipped_frames_;
+    // moving average of a single rotary update, guarded by the belief
+    // buffer mutex
+    double rotary_time_;
+    std::atomic<std::uint64_t> rotary_allocations_;
 
     State current_state_;
     // We need this to publish estimated tfs with the stamp corresponding to the
@@ -127,16 +435,45 @@ private:
     double current_time_;
     // We need this to calculate "measured" tfs at the same point in time.
     JointsObsrv current_angle_measurement_;
+    // working copies of the rotary tracker, allocated on initialization
+    State rotary_state_;
+    JointsObsrv rotary_angle_measurement_;
+    // belief entry of state_at(), allocated on initialization
+    JointsBeliefEntry state_at_entry_;
+
+    ThreadConfig rotary_thread_config_;
+    ThreadConfig visual_thread_config_;
+
+    EstimateCallback estimate_callback_;
+    // diagonal of the joint covariance passed to the estimate callback.
+    // Allocated once.
+    Eigen::VectorXd covariance_diagonal_;
 
-    sensor_msgs::Image ros_image_;
-    bool ros_image_updated_;
-    std::deque<JointsObsrvEntry> joints_obsrvs_buffer_;
-    std::deque<JointsBeliefEntry> joints_obsrv_belief_buffer_;
+    ImageObsrv image_;
+    // image time stamp corrected by the camera delay
+    double image_time_;
+    bool image_updated_;
+    // the unprocessed observation buffers hold joints_obsrv_capacity_ new
+    // observations, their remaining slots are reserved for replays. The
+    // overflow policy only applies to the joints_obsrv_new_count_ new
+    // observations at the back of the buffer.
+    int joints_obsrv_capacity_;
+    int joints_obsrv_new_count_;
+    JointsObsrvBuffer joints_obsrvs_buffer_;
+    JointsObsrvBuffer joints_obsrvs_buffer_local_;
+    JointsHistoryBuffer joints_obsrv_belief_buffer_;
+    JointsHistoryBuffer joints_obsrv_belief_buffer_local_;
+    BeliefPool belief_pool_;
+    // number of leading history entries which have left the full rate window
+    // and the index of the latest checkpoint among them (-1 if none)
+    int history_tail_size_;
+    int history_last_checkpoint_;
 
     mutable std::mutex joints_obsrv_buffer_mutex_;
     mutable std::mutex joints_obsrv_belief_buffer_mutex_;
     mutable std::mutex image_obsrvs_mutex_;
     mutable std::mutex current_state_mutex_;
+    mutable std::mutex latency_metrics_mutex_;
     std::thread gaussian_tracker_thread_;
     std::thread particle_tracker_thread_;
 };
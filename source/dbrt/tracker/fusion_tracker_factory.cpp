@@ -38,15 +38,23 @@
 #include <dbrt/kinematics_from_urdf.h>
 #include <dbrt/robot_publisher.h>
 #include <dbrt/robot_state.h>
+#include <dbrt/tracker/camera_offset_estimator.h>
 #include <dbrt/tracker/fusion_tracker.h>
 #include <dbrt/tracker/fusion_tracker_factory.h>
+#include <dbrt/tracker/motion_gate.h>
+#include <dbrt/tracker/registration_tracker_factory.h>
 #include <dbrt/tracker/robot_tracker.h>
 #include <dbrt/tracker/rotary_tracker.h>
 #include <dbrt/tracker/rotary_tracker_factory.h>
 #include <dbrt/tracker/visual_tracker.h>
 #include <dbrt/tracker/visual_tracker_factory.h>
 #include <dbrt/urdf_object_loader.h>
+#include <dbrt/util/background_model.h>
+#include <dbrt/util/camera_geometry.h>
+#include <dbrt/util/message_conversion.h>
+#include <dbrt/util/thread_config_factory.h>
 #include <fl/util/profiling.hpp>
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <ros/ros.h>
@@ -76,7 +84,7 @@ std::shared_ptr<dbrt::FusionTracker> create_fusion_tracker(
     /* ------------------------------ */
 
     std::vector<Eigen::VectorXd> initial_states_vectors = {
-        kinematics->sensor_msg_to_eigen(*joint_state)};
+        joint_state_to_eigen(kinematics, *joint_state)};
     std::vector<State> initial_states;
     for (auto state : initial_states_vectors)
     {
@@ -88,17 +96,205 @@ std::shared_ptr<dbrt::FusionTracker> create_fusion_tracker(
     /* - tracker publisher          - */
     /* ------------------------------ */
 
+    /* ------------------------------ */
+    /* - Decoupled camera offset    - */
+    /* - estimator (optional)       - */
+    /* ------------------------------ */
+    std::shared_ptr<dbrt::CameraOffsetEstimator> camera_offset_estimator;
+    if (ri::read<bool>("camera_offset/estimate_camera_offset", nh) &&
+        nh.param<bool>("camera_offset/decoupled", false))
+    {
+        camera_offset_estimator = std::make_shared<dbrt::CameraOffsetEstimator>(
+            [=]() {
+                return dbrt::create_camera_offset_tracker(
+                    prefix, kinematics, camera_data, joint_state);
+            },
+            kinematics->camera_offset_joint_indices(),
+            nh.param<int>("camera_offset/frame_subsampling", 10));
+
+        ROS_INFO("Camera offset is estimated by a decoupled estimator");
+    }
+
+    /* ------------------------------ */
+    /* - Buffer memory budget       - */
+    /* ------------------------------ */
+    dbrt::FusionTracker::BufferParameters buffer_parameters;
+    buffer_parameters.memory_budget =
+        nh.param<double>(prefix + "buffers/memory_budget_mb", 64.) * 1024 *
+        1024;
+    buffer_parameters.checkpoint_stride =
+        std::max(nh.param<int>(prefix + "buffers/checkpoint_stride", 10), 1);
+    buffer_parameters.full_rate_window =
+        nh.param<double>(prefix + "buffers/full_rate_window", 0.25);
+
+    auto overflow_policy = nh.param<std::string>(
+        prefix + "buffers/overflow_policy", "drop_oldest");
+    if (overflow_policy == "drop_oldest")
+    {
+        buffer_parameters.overflow_policy =
+            dbrt::FusionTracker::OverflowPolicy::DropOldest;
+    }
+    else if (overflow_policy == "decimate")
+    {
+        buffer_parameters.overflow_policy =
+            dbrt::FusionTracker::OverflowPolicy::Decimate;
+    }
+    else if (overflow_policy == "compress")
+    {
+        buffer_parameters.overflow_policy =
+            dbrt::FusionTracker::OverflowPolicy::Compress;
+    }
+    else
+    {
+        ROS_ERROR_STREAM("Unknown buffer overflow policy '"
+                         << overflow_policy
+                         << "'. Use drop_oldest, decimate or compress.");
+        exit(-1);
+    }
+
+    /* ------------------------------ */
+    /* - Latency budget             - */
+    /* ------------------------------ */
+    dbrt::FusionTracker::LatencyParameters latency_parameters;
+    latency_parameters.budget =
+        nh.param<double>(prefix + "latency/budget", -1.);
+    latency_parameters.reduced_sample_fraction = std::min(
+        std::max(
+            nh.param<double>(prefix + "latency/reduced_sample_fraction", 0.5),
+            0.),
+        1.);
+    latency_parameters.max_skipped_frames =
+        nh.param<int>(prefix + "latency/max_skipped_frames", 10);
+
+    /* ------------------------------ */
+    /* - Visual backend             - */
+    /* ------------------------------ */
+    dbrt::FusionTracker::VisualTrackerFactory visual_tracker_factory;
+    auto visual_backend =
+        nh.param<std::string>(prefix + "visual_backend", "particle_filter");
+    if (visual_backend == "particle_filter")
+    {
+        visual_tracker_factory = [=]() {
+            return dbrt::create_visual_tracker(
+                prefix, kinematics, camera_data, joint_state);
+        };
+    }
+    else if (visual_backend == "registration")
+    {
+        visual_tracker_factory = [=]() {
+            return dbrt::create_registration_tracker(
+                prefix, kinematics, camera_data, joint_state);
+        };
+    }
+    else
+    {
+        ROS_ERROR_STREAM("Unknown visual backend '"
+                         << visual_backend
+                         << "'. Use particle_filter or registration.");
+        exit(-1);
+    }
+
     auto fusion_tracker = std::make_shared<dbrt::FusionTracker>(
         camera_data,
         kinematics,
         [=]() {
             return dbrt::create_rotary_tracker(prefix, kinematics, joint_state);
         },
-        [=]() {
-            return dbrt::create_visual_tracker(
-                prefix, kinematics, camera_data, joint_state);
-        },
-        ri::read<double>(prefix + "camera_delay", nh));
+        visual_tracker_factory,
+        ri::read<double>(prefix + "camera_delay", nh),
+        buffer_parameters,
+        latency_parameters,
+        camera_offset_estimator);
+
+    fusion_tracker->thread_configs(
+        dbrt::create_thread_config(nh, prefix, "rotary"),
+        dbrt::create_thread_config(nh, prefix, "visual"));
+
+    /* ------------------------------ */
+    /* - Motion gate                - */
+    /* ------------------------------ */
+    if (nh.param<bool>(prefix + "motion_gate/enabled", false))
+    {
+        dbrt::MotionGate::Parameters gate_parameters;
+        gate_parameters.joint_threshold =
+            nh.param<double>(prefix + "motion_gate/joint_threshold", 0.002);
+        gate_parameters.image_change_threshold = nh.param<double>(
+            prefix + "motion_gate/image_change_threshold", 0.02);
+        gate_parameters.noise_sigma =
+            nh.param<double>(prefix + "motion_gate/noise_sigma", 0.002);
+        gate_parameters.noise_sigma_quadratic = nh.param<double>(
+            prefix + "motion_gate/noise_sigma_quadratic", 0.0029);
+        gate_parameters.noise_factor =
+            nh.param<double>(prefix + "motion_gate/noise_factor", 3.);
+        gate_parameters.link_radius =
+            nh.param<double>(prefix + "motion_gate/link_radius", 0.15);
+        gate_parameters.min_rate =
+            nh.param<double>(prefix + "motion_gate/min_rate", 1.);
+
+        fusion_tracker->motion_gate(std::make_shared<dbrt::MotionGate>(
+            kinematics, dbrt::CameraGeometry(*camera_data), gate_parameters));
+    }
+
+    /* ------------------------------ */
+    /* - Background model           - */
+    /* ------------------------------ */
+    if (nh.param<bool>(prefix + "background/enabled", false))
+    {
+        // masked pixels are invalidated. Only the SDF sensor and the
+        // registration backend skip invalid pixels for all states alike.
+        // The other sensors score them with a state dependent term, i.e.
+        // masking would change which state wins.
+        auto sensor_model =
+            nh.param<std::string>(prefix + "observation/model", "renderer");
+        if (visual_backend != "registration" && sensor_model != "sdf")
+        {
+            ROS_ERROR("Background masking requires the sdf observation "
+                      "model or the registration backend, not the %s "
+                      "observation model",
+                      sensor_model.c_str());
+            exit(-1);
+        }
+
+        dbrt::BackgroundModel::Parameters model_parameters;
+        model_parameters.learning_rate =
+            nh.param<double>(prefix + "background/learning_rate", 0.02);
+        model_parameters.min_samples =
+            nh.param<int>(prefix + "background/min_samples", 10);
+        model_parameters.noise_sigma =
+            nh.param<double>(prefix + "background/noise_sigma", 0.002);
+        model_parameters.noise_sigma_quadratic = nh.param<double>(
+            prefix + "background/noise_sigma_quadratic", 0.0029);
+        model_parameters.match_factor =
+            nh.param<double>(prefix + "background/match_factor", 3.);
+
+        auto background_model = std::make_shared<dbrt::BackgroundModel>(
+            camera_data->resolution().width,
+            camera_data->resolution().height,
+            model_parameters);
+
+        dbrt::FusionTracker::BackgroundParameters background_parameters;
+        background_parameters.link_radius =
+            nh.param<double>(prefix + "background/link_radius", 0.2);
+        background_parameters.learn =
+            nh.param<bool>(prefix + "background/learn", true);
+        background_parameters.capture_images =
+            nh.param<int>(prefix + "background/capture_images", 30);
+
+        // a captured reference is used if available. Otherwise the learned
+        // model is captured into the file.
+        auto file = nh.param<std::string>(prefix + "background/file", "");
+        if (!file.empty() && background_model->read(file))
+        {
+            ROS_INFO("Loaded background model %s", file.c_str());
+        }
+        else
+        {
+            background_parameters.capture_file = file;
+        }
+
+        fusion_tracker->background_model(background_model,
+                                         background_parameters);
+    }
 
     fusion_tracker->initialize(initial_states);
 
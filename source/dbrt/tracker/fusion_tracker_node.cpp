@@ -23,24 +23,34 @@
 #include <dbot/rigid_body_renderer.h>
 #include <dbot/virtual_camera_data_provider.h>
 #include <dbot_ros/util/ros_interface.h>
+#include <dbrt/robot_image_publisher.h>
 #include <dbrt/robot_publisher.h>
 #include <dbrt/robot_state.h>
 #include <dbrt/tracker/fusion_tracker.h>
 #include <dbrt/tracker/fusion_tracker_factory.h>
 #include <dbrt/tracker/fusion_tracker_factory.h>
+#include <dbrt/tracker/fusion_tracker_ros.h>
 #include <dbrt/tracker/robot_tracker.h>
 #include <dbrt/tracker/rotary_tracker.h>
 #include <dbrt/tracker/rotary_tracker_factory.h>
 #include <dbrt/tracker/visual_tracker.h>
 #include <dbrt/tracker/visual_tracker_factory.h>
+#include <dbrt/urdf_object_loader.h>
 #include <dbrt/util/camera_data_factory.h>
+#include <dbrt/util/camera_geometry.h>
 #include <dbrt/util/kinematics_factory.h>
+#include <dbrt/util/robot_renderer.h>
+#include <dbrt/util/shared_state_channel.h>
+#include <dbrt/util/thread_config.h>
+#include <dbrt/util/thread_config_factory.h>
 #include <fl/util/profiling.hpp>
 #include <functional>
 #include <memory>
+#include <ros/callback_queue.h>
 #include <ros/ros.h>
 #include <sensor_msgs/Image.h>
 #include <thread>
+#include <vector>
 
 /**
  * \brief Node entry point
@@ -92,25 +102,150 @@ int main(int argc, char** argv)
         "/estimated",
         ri::read<std::string>("tf_connecting_frame", nh));
 
+    /* ------------------------------ */
+    /* - Shared memory output       - */
+    /* ------------------------------ */
+    // optional zero-copy output of every estimate to co-located processes,
+    // see dbrt/util/shared_state_channel.h
+    std::shared_ptr<dbrt::SharedStateWriter> shared_state_writer;
+    auto shared_state_name = nh.param<std::string>("shared_state/name", "");
+    if (!shared_state_name.empty())
+    {
+        try
+        {
+            shared_state_writer = std::make_shared<dbrt::SharedStateWriter>(
+                shared_state_name,
+                kinematics->num_joints(),
+                nh.param<int>("shared_state/capacity", 64));
+        }
+        catch (const std::exception& e)
+        {
+            ROS_ERROR("%s", e.what());
+            exit(-1);
+        }
+
+        // conversion buffers in case the state scalar is not double
+        auto values = std::make_shared<Eigen::VectorXd>(
+            Eigen::VectorXd::Zero(kinematics->num_joints()));
+        fusion_tracker->estimate_callback(
+            [shared_state_writer, values](
+                double timestamp,
+                const dbrt::FusionTracker::State& state,
+                const Eigen::VectorXd& covariance_diagonal) {
+                *values = state.cast<double>();
+                shared_state_writer->write(
+                    timestamp, values->data(), covariance_diagonal.data());
+            });
+
+        ROS_INFO("Writing estimates to shared memory %s",
+                 shared_state_name.c_str());
+    }
+
+    /* ------------------------------ */
+    /* - Real-time setup            - */
+    /* ------------------------------ */
+    // lock after the buffers have been allocated and before the tracker
+    // threads start
+    if (nh.param<bool>("threads/lock_memory", false))
+    {
+        dbrt::lock_process_memory();
+    }
+
     /* ------------------------------ */
     /* - Run tracker node           - */
     /* ------------------------------ */
     fusion_tracker->run();
 
+    dbrt::FusionTrackerRos fusion_tracker_ros(fusion_tracker, kinematics);
+
     ros::Subscriber joint_subscriber =
         nh.subscribe("/joint_states",
                      1000,
-                     &dbrt::FusionTracker::joints_obsrv_callback,
-                     fusion_tracker.get());
+                     &dbrt::FusionTrackerRos::joints_obsrv_callback,
+                     &fusion_tracker_ros);
 
     ros::Subscriber image_subscriber =
         nh.subscribe(ri::read<std::string>("depth_image_topic", nh),
                      1,
-                     &dbrt::FusionTracker::image_obsrv_callback,
-                     fusion_tracker.get());
+                     &dbrt::FusionTrackerRos::image_obsrv_callback,
+                     &fusion_tracker_ros);
 
-    ros::AsyncSpinner spinner(20);
-    spinner.start();
+    /* ------------------------------ */
+    /* - Robot image output         - */
+    /* ------------------------------ */
+    // optional depth, mask and link index images of the estimate, e.g. for
+    // self-filtering point clouds, see dbrt/robot_image_publisher.h
+    std::thread robot_image_thread;
+    auto robot_image_rate = nh.param<double>("robot_image/rate", 0.);
+    if (robot_image_rate > 0.)
+    {
+        auto object_model = std::make_shared<dbot::ObjectModel>(
+            std::make_shared<dbrt::UrdfObjectModelLoader>(kinematics), false);
+
+        // the camera matrix of the camera data refers to the downsampled
+        // resolution
+        Eigen::Matrix3d camera_matrix = camera_data->camera_matrix();
+        camera_matrix.topRows(2) *= camera_data->downsampling_factor();
+        auto camera_geometry =
+            dbrt::CameraGeometry(camera_matrix,
+                                 camera_data->native_resolution().width,
+                                 camera_data->native_resolution().height)
+                .downsampled(
+                    nh.param<int>("robot_image/downsampling_factor",
+                                  camera_data->downsampling_factor()));
+
+        auto robot_image_publisher =
+            std::make_shared<dbrt::RobotImagePublisher>(
+                std::make_shared<dbrt::RobotRenderer>(
+                    kinematics, *object_model, camera_geometry),
+                "/estimated",
+                camera_data->frame_id(),
+                nh.param<bool>("robot_image/depth", true),
+                nh.param<bool>("robot_image/mask", true),
+                nh.param<bool>("robot_image/link_ids", false));
+
+        auto robot_image_thread_config =
+            dbrt::create_thread_config(nh, "", "robot_image");
+        robot_image_thread = std::thread([=]() {
+            dbrt::apply_thread_config("dbrt_robot_image",
+                                      robot_image_thread_config);
+
+            // one rendering of the mean state per cycle
+            ros::Rate rate(robot_image_rate);
+            State state;
+            double time;
+            while (ros::ok())
+            {
+                rate.sleep();
+                fusion_tracker->current_state_and_time(state, time);
+                robot_image_publisher->publish(state, ros::Time(time));
+            }
+        });
+
+        ROS_INFO("Publishing robot images at %f Hz", robot_image_rate);
+    }
+
+    // callback threads serving the global callback queue. Replaces the
+    // AsyncSpinner such that the threads can be pinned and prioritized.
+    auto callback_thread_config =
+        dbrt::create_thread_config(nh, "", "callbacks");
+    std::vector<std::thread> callback_threads;
+    for (int i = 0; i < nh.param<int>("threads/callbacks/count", 20); ++i)
+    {
+        callback_threads.emplace_back([i, callback_thread_config]() {
+            dbrt::apply_thread_config("dbrt_callback" + std::to_string(i),
+                                      callback_thread_config);
+            while (ros::ok())
+            {
+                ros::getGlobalCallbackQueue()->callAvailable(
+                    ros::WallDuration(0.1));
+            }
+        });
+    }
+
+    // the main thread publishes the estimates
+    dbrt::apply_thread_config("dbrt_publisher",
+                              dbrt::create_thread_config(nh, "", "publisher"));
 
     ros::Rate visualization_rate(100);
     while (ros::ok())
@@ -131,10 +266,21 @@ int main(int argc, char** argv)
 
             tracker_publisher->publish_joint_state(current_state,
                                                    ros::Time(current_time));
+
+            tracker_publisher->publish_link_poses(current_state,
+                                                  ros::Time(current_time));
         }
     }
 
     ROS_INFO("Shutting down ...");
+    for (auto& callback_thread : callback_threads)
+    {
+        callback_thread.join();
+    }
+    if (robot_image_thread.joinable())
+    {
+        robot_image_thread.join();
+    }
     fusion_tracker->shutdown();
 
     return 0;
@@ -0,0 +1,45 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file fusion_tracker_ros.cpp
+ * \date October 2026
+ */
+
+#include <dbrt/tracker/fusion_tracker_ros.h>
+
+namespace dbrt
+{
+FusionTrackerRos::FusionTrackerRos(
+    const std::shared_ptr<FusionTracker>& tracker,
+    const std::shared_ptr<KinematicsFromURDF>& kinematics)
+    : tracker_(tracker), joint_state_converter_(kinematics)
+{
+}
+
+void FusionTrackerRos::joints_obsrv_callback(
+    const sensor_msgs::JointState& joint_state)
+{
+    tracker_->joints_obsrv(joint_state.header.stamp.toSec(),
+                           joint_state_converter_.convert(joint_state));
+}
+
+void FusionTrackerRos::image_obsrv_callback(
+    const sensor_msgs::Image& ros_image)
+{
+    DepthImageView image;
+    if (!to_depth_image_view(ros_image, image)) return;
+
+    tracker_->image_obsrv(image);
+}
+}
@@ -0,0 +1,49 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file fusion_tracker_ros.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <dbrt/kinematics_from_urdf.h>
+#include <dbrt/tracker/fusion_tracker.h>
+#include <dbrt/util/message_conversion.h>
+#include <memory>
+#include <sensor_msgs/Image.h>
+#include <sensor_msgs/JointState.h>
+
+namespace dbrt
+{
+/**
+ * \brief Feeds ROS joint state and depth image messages into a
+ *     FusionTracker without copying the messages
+ */
+class FusionTrackerRos
+{
+public:
+    FusionTrackerRos(const std::shared_ptr<FusionTracker>& tracker,
+                     const std::shared_ptr<KinematicsFromURDF>& kinematics);
+
+    void joints_obsrv_callback(const sensor_msgs::JointState& joint_state);
+    void image_obsrv_callback(const sensor_msgs::Image& ros_image);
+
+    const std::shared_ptr<FusionTracker>& tracker() { return tracker_; }
+
+private:
+    std::shared_ptr<FusionTracker> tracker_;
+    JointStateConverter joint_state_converter_;
+};
+}
@@ -0,0 +1,151 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file motion_gate.cpp
+ * \date October 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <dbrt/tracker/motion_gate.h>
+#include <dbrt/util/robot_roi.h>
+#include <limits>
+
+namespace dbrt
+{
+MotionGate::MotionGate(const std::shared_ptr<KinematicsFromURDF>& kinematics,
+                       const CameraGeometry& camera_geometry,
+                       const Parameters& parameters)
+    : kinematics_(kinematics),
+      camera_geometry_(camera_geometry),
+      parameters_(parameters),
+      metrics_(),
+      has_reference_(false),
+      reference_time_(0.),
+      reference_mean_(),
+      reference_image_(Image::Zero(camera_geometry.pixels())),
+      image_period_(0.),
+      last_image_time_(std::numeric_limits<double>::quiet_NaN())
+{
+    metrics_.open = true;
+    metrics_.image_change = -1.;
+}
+
+bool MotionGate::check(double image_time,
+                       const Eigen::VectorXd& mean,
+                       const Image& image)
+{
+    const double period = image_time - last_image_time_;
+    if (period > 0.)
+    {
+        image_period_ = image_period_ > 0.
+                            ? 0.9 * image_period_ + 0.1 * period
+                            : period;
+    }
+    last_image_time_ = image_time;
+
+    metrics_.image_change = -1.;
+    metrics_.stationary = false;
+    if (has_reference_ && mean.size() == reference_mean_.size() &&
+        image.size() == reference_image_.size())
+    {
+        metrics_.joint_displacement =
+            (mean - reference_mean_).cwiseAbs().maxCoeff();
+
+        // the image difference is only worth computing if the joints
+        // agree
+        if (metrics_.joint_displacement <= parameters_.joint_threshold)
+        {
+            metrics_.image_change = image_change(mean, image);
+            metrics_.stationary = metrics_.image_change <=
+                                  parameters_.image_change_threshold;
+        }
+    }
+
+    if (!metrics_.stationary)
+    {
+        metrics_.interval = 0.;
+        metrics_.open = true;
+        metrics_.passed_frames++;
+        return true;
+    }
+
+    metrics_.open = image_time - reference_time_ >= metrics_.interval;
+    if (!metrics_.open)
+    {
+        metrics_.gated_frames++;
+        return false;
+    }
+
+    // back off further while the robot remains stationary
+    const double max_interval =
+        parameters_.min_rate > 0. ? 1. / parameters_.min_rate
+                                  : std::numeric_limits<double>::infinity();
+    metrics_.interval = std::min(
+        std::max(2. * metrics_.interval, image_period_), max_interval);
+    metrics_.passed_frames++;
+    return true;
+}
+
+void MotionGate::processed(double image_time,
+                           const Eigen::VectorXd& mean,
+                           const Image& image)
+{
+    if (image.size() != reference_image_.size()) return;
+
+    // allocates only on the first call
+    has_reference_ = true;
+    reference_time_ = image_time;
+    reference_mean_ = mean;
+    reference_image_ = image;
+}
+
+double MotionGate::image_change(const Eigen::VectorXd& mean,
+                                const Image& image)
+{
+    const PixelRoi roi = robot_roi(
+        *kinematics_, camera_geometry_, mean, parameters_.link_radius);
+
+    // the robot is out of view, nothing to correct
+    if (roi.empty()) return 0.;
+
+    const int width = camera_geometry_.width();
+    int changed = 0;
+    for (int v = roi.v_min; v <= roi.v_max; ++v)
+    {
+        for (int i = v * width + roi.u_min; i <= v * width + roi.u_max; ++i)
+        {
+            const fl::Real depth = image(i);
+            const fl::Real reference = reference_image_(i);
+            const bool valid = std::isfinite(depth);
+            if (valid != std::isfinite(reference))
+            {
+                changed++;
+                continue;
+            }
+            if (!valid) continue;
+
+            const double sigma =
+                parameters_.noise_sigma +
+                parameters_.noise_sigma_quadratic * reference * reference;
+            if (std::fabs(depth - reference) > parameters_.noise_factor * sigma)
+            {
+                changed++;
+            }
+        }
+    }
+
+    return double(changed) / roi.area();
+}
+}
@@ -0,0 +1,138 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file motion_gate.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <dbrt/kinematics_from_urdf.h>
+#include <dbrt/util/camera_geometry.h>
+#include <fl/util/types.hpp>
+#include <memory>
+
+namespace dbrt
+{
+/**
+ * \brief Decides whether a depth image needs a visual update while the robot
+ *     is stationary.
+ *
+ * An image is considered redundant if the rotary mean at its time stamp
+ * differs from the mean of the last processed image by less than a joint
+ * threshold and if only a small fraction of the pixels within the robot
+ * region changed beyond the depth noise. The robot region is the image
+ * region covered by spheres around the link origins.
+ *
+ * Redundant images are not dropped entirely. The interval between processed
+ * images doubles with every processed redundant image, starting at the image
+ * period, up to the inverse of the minimum update rate. Any motion restores
+ * the full rate.
+ */
+class MotionGate
+{
+public:
+    typedef Eigen::Matrix<fl::Real, Eigen::Dynamic, 1> Image;
+
+    struct Parameters
+    {
+        // maximum absolute joint displacement in radians since the last
+        // processed image for which the robot is considered stationary
+        double joint_threshold;
+        // maximum fraction of changed pixels within the robot region for
+        // which the image is considered unchanged
+        double image_change_threshold;
+        // depth noise sigma(d) = noise_sigma + noise_sigma_quadratic * d^2.
+        // A pixel changed if its depth differs by more than
+        // noise_factor * sigma(d) or if its validity changed.
+        double noise_sigma;
+        double noise_sigma_quadratic;
+        double noise_factor;
+        // radius of the spheres around the link origins in meters
+        double link_radius;
+        // minimum rate of visual updates while stationary in Hz
+        double min_rate;
+    };
+
+    /**
+     * \brief Gate state and the statistics of the latest image
+     */
+    struct Metrics
+    {
+        // whether the latest image passed the gate
+        bool open;
+        // whether the latest image was considered redundant
+        bool stationary;
+        // maximum absolute joint displacement since the last processed image
+        double joint_displacement;
+        // fraction of changed pixels within the robot region, -1 if the
+        // image difference has not been evaluated
+        double image_change;
+        // current interval between processed redundant images in seconds
+        double interval;
+        int passed_frames;
+        int gated_frames;
+    };
+
+public:
+    MotionGate(const std::shared_ptr<KinematicsFromURDF>& kinematics,
+               const CameraGeometry& camera_geometry,
+               const Parameters& parameters);
+
+    /**
+     * \brief Returns true if the image at the given time stamp has to be
+     *     processed. The image difference is only evaluated if the joint
+     *     displacement is below the threshold.
+     *
+     * \param mean
+     *     Rotary mean at the image time stamp
+     */
+    bool check(double image_time,
+               const Eigen::VectorXd& mean,
+               const Image& image);
+
+    /**
+     * \brief Records the processed image and the rotary mean at its time
+     *     stamp as the reference for subsequent images. Does not allocate.
+     */
+    void processed(double image_time,
+                   const Eigen::VectorXd& mean,
+                   const Image& image);
+
+    const Metrics& metrics() const { return metrics_; }
+
+private:
+    /**
+     * \brief Fraction of changed pixels within the robot region at the
+     *     given joint state
+     */
+    double image_change(const Eigen::VectorXd& mean, const Image& image);
+
+private:
+    std::shared_ptr<KinematicsFromURDF> kinematics_;
+    CameraGeometry camera_geometry_;
+    Parameters parameters_;
+    Metrics metrics_;
+
+    bool has_reference_;
+    double reference_time_;
+    Eigen::VectorXd reference_mean_;
+    Image reference_image_;
+
+    // moving average of the image period
+    double image_period_;
+    double last_image_time_;
+};
+}
@@ -0,0 +1,271 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file registration_tracker.cpp
+ * \date October 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <dbrt/robot_state.h>
+#include <dbrt/tracker/registration_tracker.h>
+#include <mutex>
+
+namespace dbrt
+{
+RegistrationTracker::RegistrationTracker(
+    const std::shared_ptr<KinematicsFromURDF>& kinematics,
+    const std::shared_ptr<dbot::ObjectModel>& object_model,
+    const std::shared_ptr<dbot::CameraData>& camera_data,
+    const Parameters& parameters)
+    : kinematics_(kinematics),
+      camera_data_(camera_data),
+      parameters_(parameters),
+      iterations_(parameters.max_iterations)
+{
+    // the object model has been loaded through the kinematics, i.e. its
+    // parts are ordered like the kinematics links
+    samples_ = sample_surfaces(*object_model, parameters_.points_per_link, 0);
+
+    const int joint_count = kinematics_->num_joints();
+    prior_mean_ = Eigen::VectorXd::Zero(joint_count);
+    prior_std_ = Eigen::VectorXd::Zero(joint_count);
+    covariance_ = Eigen::MatrixXd::Zero(joint_count, joint_count);
+    hessian_ = Eigen::MatrixXd::Zero(joint_count, joint_count);
+    gradient_ = Eigen::VectorXd::Zero(joint_count);
+    trial_hessian_ = hessian_;
+    trial_gradient_ = gradient_;
+    system_ = hessian_;
+    rhs_ = gradient_;
+    rotations_.resize(samples_.size());
+    translations_.resize(samples_.size());
+    jacobians_.resize(samples_.size());
+    row_ = Eigen::VectorXd::Zero(joint_count);
+}
+
+void RegistrationTracker::initialize(const std::vector<State>& initial_states)
+{
+    prior_mean_ = initial_states[0];
+}
+
+void RegistrationTracker::set_prior(const State& mean,
+                                    const Eigen::VectorXd& std_diagonal,
+                                    double effort)
+{
+    prior_mean_ = mean;
+    prior_std_ = std_diagonal;
+    iterations_ = std::max<int>(
+        std::lround(effort * parameters_.max_iterations), 1);
+}
+
+Eigen::MatrixXd RegistrationTracker::covariance()
+{
+    return covariance_;
+}
+
+auto RegistrationTracker::track(const Obsrv& image) -> State
+{
+    State state = prior_mean_;
+    double cost = linearize(state, image, hessian_, gradient_) +
+                  add_prior(state, hessian_, gradient_);
+
+    double damping = parameters_.damping;
+    for (int i = 0; i < iterations_; ++i)
+    {
+        system_ = hessian_;
+        system_.diagonal() *= 1. + damping;
+        rhs_ = -gradient_;
+        fix_joints(system_, rhs_);
+
+        Eigen::VectorXd delta = system_.ldlt().solve(rhs_);
+        State trial = state + delta;
+
+        double trial_cost =
+            linearize(trial, image, trial_hessian_, trial_gradient_) +
+            add_prior(trial, trial_hessian_, trial_gradient_);
+
+        if (trial_cost < cost)
+        {
+            // accept and move towards Gauss-Newton
+            state = trial;
+            cost = trial_cost;
+            hessian_.swap(trial_hessian_);
+            gradient_.swap(trial_gradient_);
+            damping *= 0.1;
+
+            if (delta.cwiseAbs().maxCoeff() < parameters_.convergence_threshold)
+            {
+                break;
+            }
+        }
+        else
+        {
+            // reject and move towards gradient descent
+            damping *= 10.;
+        }
+    }
+
+    // Laplace approximation of the posterior at the estimate
+    system_ = hessian_;
+    rhs_.setZero();
+    fix_joints(system_, rhs_);
+    covariance_ = system_.ldlt().solve(
+        Eigen::MatrixXd::Identity(state.size(), state.size()));
+    for (int i = 0; i < prior_std_.size(); ++i)
+    {
+        if (prior_std_(i) > 0.) continue;
+        covariance_.row(i).setZero();
+        covariance_.col(i).setZero();
+    }
+
+    return state;
+}
+
+double RegistrationTracker::linearize(const State& state,
+                                      const Obsrv& image,
+                                      Eigen::MatrixXd& hessian,
+                                      Eigen::VectorXd& gradient)
+{
+    const int joint_count = state.size();
+    hessian.setZero(joint_count, joint_count);
+    gradient.setZero(joint_count);
+
+    update_link_poses(state);
+
+    const Eigen::Matrix3d camera_matrix = camera_data_->camera_matrix();
+    const int width = camera_data_->resolution().width;
+    const int height = camera_data_->resolution().height;
+    const double precision =
+        1. / (parameters_.depth_sigma * parameters_.depth_sigma);
+    const double huber_threshold =
+        parameters_.huber_threshold * parameters_.depth_sigma;
+
+    double cost = 0.;
+    for (int link = 0; link < samples_.size(); ++link)
+    {
+        const SurfaceSamples& samples = samples_[link];
+        if (samples.points.empty()) continue;
+
+        const Eigen::Matrix3d& rotation = rotations_[link];
+        const Eigen::Vector3d& translation = translations_[link];
+        const Eigen::MatrixXd& jacobian = jacobians_[link];
+
+        for (int k = 0; k < samples.points.size(); ++k)
+        {
+            const Eigen::Vector3d point =
+                rotation * samples.points[k] + translation;
+            const Eigen::Vector3d normal = rotation * samples.normals[k];
+
+            // behind the camera or facing away from it
+            if (point.z() <= 0. || normal.dot(point) >= 0.) continue;
+
+            // projective association
+            // range checked before the conversion, which also rejects NaN
+            const double u = std::floor(
+                camera_matrix(0, 0) * point.x() / point.z() +
+                camera_matrix(0, 2) + 0.5);
+            const double v = std::floor(
+                camera_matrix(1, 1) * point.y() / point.z() +
+                camera_matrix(1, 2) + 0.5);
+            if (!(u >= 0. && u < width && v >= 0. && v < height)) continue;
+
+            const double depth = image(int(v) * width + int(u));
+            if (!std::isfinite(depth) ||
+                std::fabs(depth - point.z()) > parameters_.outlier_threshold)
+            {
+                continue;
+            }
+
+            // point-to-plane distance to the observed point on the same ray
+            const double residual =
+                normal.dot(point) * (1. - depth / point.z());
+
+            // derivative of the residual with respect to all joints
+            row_.noalias() = jacobian.topRows<3>().transpose() * normal;
+            row_.noalias() += jacobian.bottomRows<3>().transpose() *
+                              (point - translation).cross(normal);
+
+            // Huber loss
+            const double magnitude = std::fabs(residual);
+            double weight = 1.;
+            if (magnitude <= huber_threshold)
+            {
+                cost += 0.5 * precision * residual * residual;
+            }
+            else
+            {
+                weight = huber_threshold / magnitude;
+                cost += precision * huber_threshold *
+                        (magnitude - 0.5 * huber_threshold);
+            }
+
+            hessian.selfadjointView<Eigen::Lower>().rankUpdate(
+                row_, weight * precision);
+            gradient.noalias() += (weight * precision * residual) * row_;
+        }
+    }
+    hessian.triangularView<Eigen::StrictlyUpper>() = hessian.transpose();
+
+    return cost;
+}
+
+void RegistrationTracker::update_link_poses(const State& state)
+{
+    // the kinematics are shared with the robot states and the publishers
+    std::lock_guard<std::mutex> lock(*RobotState<>::kinematics_mutex_);
+    kinematics_->set_joint_angles(state);
+    for (int link = 0; link < int(samples_.size()); ++link)
+    {
+        if (samples_[link].points.empty()) continue;
+
+        rotations_[link] =
+            kinematics_->get_link_orientation(link).toRotationMatrix();
+        translations_[link] = kinematics_->get_link_position(link);
+        kinematics_->get_link_jacobian(link, jacobians_[link]);
+    }
+}
+
+double RegistrationTracker::add_prior(const State& state,
+                                      Eigen::MatrixXd& hessian,
+                                      Eigen::VectorXd& gradient) const
+{
+    double cost = 0.;
+    for (int i = 0; i < prior_std_.size(); ++i)
+    {
+        if (prior_std_(i) <= 0.) continue;
+
+        const double precision = 1. / (prior_std_(i) * prior_std_(i));
+        const double difference = state(i) - prior_mean_(i);
+        cost += 0.5 * precision * difference * difference;
+        hessian(i, i) += precision;
+        gradient(i) += precision * difference;
+    }
+
+    return cost;
+}
+
+void RegistrationTracker::fix_joints(Eigen::MatrixXd& system,
+                                     Eigen::VectorXd& rhs) const
+{
+    for (int i = 0; i < prior_std_.size(); ++i)
+    {
+        if (prior_std_(i) > 0.) continue;
+
+        system.row(i).setZero();
+        system.col(i).setZero();
+        system(i, i) = 1.;
+        rhs(i) = 0.;
+    }
+}
+}
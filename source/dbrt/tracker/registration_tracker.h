@@ -0,0 +1,143 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file registration_tracker.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <dbot/camera_data.h>
+#include <dbot/object_model.h>
+#include <dbrt/kinematics_from_urdf.h>
+#include <dbrt/model/surface_sampler.h>
+#include <dbrt/tracker/depth_tracker.h>
+#include <memory>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Visual tracker registering the articulated robot model to the depth
+ *     image by Levenberg-Marquardt iterations.
+ *
+ * Each iteration transforms a fixed set of surface samples per link into the
+ * camera frame, associates each sample with the observed depth at its pixel
+ * (projective association) and linearizes the point-to-plane residuals using
+ * the link Jacobians. The prior belief enters as a Gaussian regularizer, the
+ * returned covariance is the inverse of the Gauss-Newton Hessian at the
+ * estimate. Occluded samples and background are rejected by a depth gate.
+ */
+class RegistrationTracker : public DepthTracker
+{
+public:
+    struct Parameters
+    {
+        // iterations per image at full effort
+        int max_iterations;
+        // surface samples per mesh link
+        int points_per_link;
+        // standard deviation of the point-to-plane residual in meters
+        double depth_sigma;
+        // samples further off the observed depth are rejected, in meters
+        double outlier_threshold;
+        // residuals beyond this multiple of depth_sigma are down-weighted
+        double huber_threshold;
+        // initial Levenberg-Marquardt damping
+        double damping;
+        // iterations stop once no joint changes more than this
+        double convergence_threshold;
+    };
+
+public:
+    RegistrationTracker(const std::shared_ptr<KinematicsFromURDF>& kinematics,
+                        const std::shared_ptr<dbot::ObjectModel>& object_model,
+                        const std::shared_ptr<dbot::CameraData>& camera_data,
+                        const Parameters& parameters);
+
+    /**
+     * \brief Registers the model to the given depth image starting at the
+     *     prior mean
+     */
+    State track(const Obsrv& image);
+
+    /**
+     * \brief Sets the prior mean to the first of the given states. The prior
+     *     standard deviation is unchanged.
+     */
+    void initialize(const std::vector<State>& initial_states);
+
+    void set_prior(const State& mean,
+                   const Eigen::VectorXd& std_diagonal,
+                   double effort);
+
+    Eigen::MatrixXd covariance();
+
+private:
+    /**
+     * \brief Accumulates the normal equations of the depth residuals at the
+     *     given state. Returns the robust cost.
+     */
+    double linearize(const State& state,
+                     const Obsrv& image,
+                     Eigen::MatrixXd& hessian,
+                     Eigen::VectorXd& gradient);
+
+    /**
+     * \brief Computes the poses and Jacobians of all links at the given
+     *     state while holding the kinematics lock
+     */
+    void update_link_poses(const State& state);
+
+    /**
+     * \brief Adds the prior to the normal equations and returns its cost
+     */
+    double add_prior(const State& state,
+                     Eigen::MatrixXd& hessian,
+                     Eigen::VectorXd& gradient) const;
+
+    /**
+     * \brief Removes the fixed joints from the linear system by replacing
+     *     their equations with delta = 0
+     */
+    void fix_joints(Eigen::MatrixXd& system, Eigen::VectorXd& rhs) const;
+
+private:
+    std::shared_ptr<KinematicsFromURDF> kinematics_;
+    std::shared_ptr<dbot::CameraData> camera_data_;
+    Parameters parameters_;
+    std::vector<SurfaceSamples> samples_;
+
+    State prior_mean_;
+    // zero for fixed joints
+    Eigen::VectorXd prior_std_;
+    int iterations_;
+
+    Eigen::MatrixXd covariance_;
+
+    // link poses and Jacobians at the current iterate
+    std::vector<Eigen::Matrix3d> rotations_;
+    std::vector<Eigen::Vector3d> translations_;
+    std::vector<Eigen::MatrixXd> jacobians_;
+
+    // preallocated normal equations
+    Eigen::MatrixXd hessian_;
+    Eigen::VectorXd gradient_;
+    Eigen::MatrixXd trial_hessian_;
+    Eigen::VectorXd trial_gradient_;
+    Eigen::MatrixXd system_;
+    Eigen::VectorXd rhs_;
+    Eigen::VectorXd row_;
+};
+}
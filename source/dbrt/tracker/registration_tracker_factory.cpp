@@ -0,0 +1,73 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file registration_tracker_factory.cpp
+ * \date October 2026
+ */
+
+#include <dbrt/tracker/registration_tracker_factory.h>
+#include <dbrt/urdf_object_loader.h>
+#include <dbrt/util/message_conversion.h>
+#include <ros/ros.h>
+
+namespace dbrt
+{
+std::shared_ptr<dbrt::RegistrationTracker> create_registration_tracker(
+    std::string prefix,
+    std::shared_ptr<KinematicsFromURDF> kinematics,
+    std::shared_ptr<dbot::CameraData> camera_data,
+    sensor_msgs::JointState::ConstPtr joint_state)
+{
+    ros::NodeHandle nh("~");
+
+    /* ------------------------------ */
+    /* - Create the robot model     - */
+    /* ------------------------------ */
+    auto object_model = std::make_shared<dbot::ObjectModel>(
+        std::make_shared<dbrt::UrdfObjectModelLoader>(kinematics), false);
+
+    ROS_INFO("Robot model loaded");
+
+    /* ------------------------------ */
+    /* - Create the tracker         - */
+    /* ------------------------------ */
+    dbrt::RegistrationTracker::Parameters parameters;
+    parameters.max_iterations =
+        nh.param<int>(prefix + "registration/max_iterations", 5);
+    parameters.points_per_link =
+        nh.param<int>(prefix + "registration/points_per_link", 200);
+    parameters.depth_sigma =
+        nh.param<double>(prefix + "registration/depth_sigma", 0.01);
+    parameters.outlier_threshold =
+        nh.param<double>(prefix + "registration/outlier_threshold", 0.05);
+    parameters.huber_threshold =
+        nh.param<double>(prefix + "registration/huber_threshold", 2.);
+    parameters.damping =
+        nh.param<double>(prefix + "registration/damping", 1e-3);
+    parameters.convergence_threshold = nh.param<double>(
+        prefix + "registration/convergence_threshold", 1e-5);
+
+    auto tracker = std::make_shared<dbrt::RegistrationTracker>(
+        kinematics, object_model, camera_data, parameters);
+
+    /* ------------------------------ */
+    /* - Initialize tracker         - */
+    /* ------------------------------ */
+    std::vector<dbrt::RobotState<>> initial_states = {
+        dbrt::RobotState<>(joint_state_to_eigen(kinematics, *joint_state))};
+    tracker->initialize(initial_states);
+
+    return tracker;
+}
+}
@@ -0,0 +1,42 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file registration_tracker_factory.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <dbot/camera_data.h>
+#include <dbrt/kinematics_from_urdf.h>
+#include <dbrt/tracker/registration_tracker.h>
+#include <memory>
+#include <sensor_msgs/JointState.h>
+#include <string>
+
+namespace dbrt
+{
+/**
+ * \brief Create a tracker registering the robot model to depth images
+ * \param prefix
+ *     parameter prefix, e.g. fusion_tracker
+ * \param kinematics
+ *     URDF robot kinematics
+ */
+std::shared_ptr<dbrt::RegistrationTracker> create_registration_tracker(
+    std::string prefix,
+    std::shared_ptr<KinematicsFromURDF> kinematics,
+    std::shared_ptr<dbot::CameraData> camera_data,
+    sensor_msgs::JointState::ConstPtr joint_state);
+}
@@ -29,11 +29,6 @@ RotaryTracker::RotaryTracker(
 {
 }
 
-void RotaryTracker::track_callback(const sensor_msgs::JointState& joint_msg)
-{
-    track(kinematics_->sensor_msg_to_eigen(joint_msg));
-}
-
 const std::vector<RotaryTracker::JointBelief>& RotaryTracker::beliefs() const
 {
     return beliefs_;
@@ -135,7 +130,17 @@ void RotaryTracker::initialize(const std::vector<State>& initial_states)
 auto RotaryTracker::track(const Obsrv& joints_obsrv) -> State
 {
     State state;
-    state.resize(joint_filters_->size());
+    track(joints_obsrv, state);
+
+    return state;
+}
+
+void RotaryTracker::track(const Obsrv& joints_obsrv, State& state)
+{
+    if (state.size() != joint_filters_->size())
+    {
+        state.resize(joint_filters_->size());
+    }
 
     for (int i = 0; i < joint_filters_->size(); ++i)
     {
@@ -150,7 +155,5 @@ auto RotaryTracker::track(const Obsrv& joints_obsrv) -> State
 
     //    std::lock_guard<std::mutex> lock(mutex_);
     current_state_ = state;
-
-    return state;
 }
 }
@@ -27,7 +27,6 @@
 #include <fl/model/transition/linear_transition.hpp>
 #include <memory>
 #include <mutex>
-#include <sensor_msgs/JointState.h>
 
 namespace dbrt
 {
@@ -80,6 +79,13 @@ public:
      */
     State track(const Obsrv& joints_obsrv);
 
+    /**
+     * \brief perform a single filter step and write the resulting state
+     *     into the given state. Does not allocate if the state has the
+     *     size of the joint count.
+     */
+    void track(const Obsrv& joints_obsrv, State& state);
+
     /**
      * \brief Initializes the particle filter with the given initial states and
      *    the number of evaluations
@@ -120,11 +126,6 @@ public:
      */
     State current_state() const;
 
-    /**
-     * Callback function to apply the filter for the given joint state message
-     */
-    void track_callback(const sensor_msgs::JointState& joint_msg);
-
 private:
     /* std::vector<int> joint_order_; */
     std::shared_ptr<KinematicsFromURDF> kinematics_;
@@ -19,6 +19,7 @@
 #include <dbot_ros/util/ros_interface.h>
 #include <dbrt/builder/rotary_tracker_builder.h>
 #include <dbrt/tracker/rotary_tracker_factory.h>
+#include <dbrt/util/message_conversion.h>
 #include <dbrt/util/parameter_tools.h>
 #include <ros/ros.h>
 
@@ -139,7 +140,7 @@ std::shared_ptr<dbrt::RotaryTracker> create_rotary_tracker(
     /* - Initialize tracker         - */
     /* ------------------------------ */
     std::vector<Eigen::VectorXd> initial_states_vectors = {
-        kinematics->sensor_msg_to_eigen(*joint_state)};
+        joint_state_to_eigen(kinematics, *joint_state)};
     std::vector<dbrt::RobotState<>> initial_states;
     for (auto state : initial_states_vectors) initial_states.push_back(state);
     tracker->initialize(initial_states);
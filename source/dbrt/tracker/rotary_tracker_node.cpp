@@ -42,6 +42,7 @@
 #include <dbrt/tracker/rotary_tracker_factory.h>
 #include <dbrt/tracker/visual_tracker.h>
 #include <dbrt/urdf_object_loader.h>
+#include <dbrt/util/message_conversion.h>
 #include <dbrt/util/kinematics_factory.h>
 #include <sensor_msgs/Image.h>
 
@@ -93,8 +94,13 @@ int main(int argc, char** argv)
     /* ------------------------------ */
     ROS_INFO("Running rotary tracker");
 
-    ros::Subscriber subscriber = nh.subscribe(
-        "/joint_states", 1, &dbrt::RotaryTracker::track_callback, &(*tracker));
+    dbrt::JointStateConverter joint_state_converter(kinematics);
+    ros::Subscriber subscriber = nh.subscribe<sensor_msgs::JointState>(
+        "/joint_states",
+        1,
+        [&](const sensor_msgs::JointState::ConstPtr& joint_state) {
+            tracker->track(joint_state_converter.convert(*joint_state));
+        });
 
     ros::Rate visualization_rate(100);
     while (ros::ok())
@@ -29,7 +29,9 @@
  * \author Manuel Wuthrich (manuel.wuthrich@gmail.com)
  */
 
+#include <algorithm>
 #include <dbot/rigid_body_renderer.h>
+#include <dbrt/model/diagonal_transition.h>
 #include <dbrt/tracker/visual_tracker.h>
 
 namespace dbrt
@@ -47,9 +49,36 @@ VisualTracker::VisualTracker(
 }
 
 void VisualTracker::initialize(const std::vector<State>& initial_states)
+{
+    initialize(initial_states, evaluation_count_);
+}
+
+void VisualTracker::initialize(const std::vector<State>& initial_states,
+                               int evaluation_count)
 {
     filter_->set_particles(initial_states);
-    filter_->resample(evaluation_count_ / block_count_);
+    filter_->resample(std::max(evaluation_count / block_count_, 1));
+}
+
+int VisualTracker::evaluation_count() const
+{
+    return evaluation_count_;
+}
+
+void VisualTracker::set_prior(const State& mean,
+                              const Eigen::VectorXd& std_diagonal,
+                              double effort)
+{
+    std::static_pointer_cast<DiagonalTransition<State, Noise, Input>>(
+        filter_->transition())
+        ->noise_diagonal(std_diagonal);
+
+    initialize({mean}, std::max<int>(effort * evaluation_count_, 1));
+}
+
+Eigen::MatrixXd VisualTracker::covariance()
+{
+    return filter_->belief().covariance();
 }
 
 const std::shared_ptr<VisualTracker::Filter> VisualTracker::filter()
@@ -59,6 +88,10 @@ const std::shared_ptr<VisualTracker::Filter> VisualTracker::filter()
 
 auto VisualTracker::track(const Obsrv& image) -> State
 {
+    // identical particles are not merged before scoring. Resampled copies
+    // only share the blocks evaluated so far. Each block is diffused before
+    // it is evaluated, and fixed joints are in no block, so no two
+    // evaluated states coincide.
     filter_->filter(image, zero_input());
 
     State mean = filter_->belief().mean();
@@ -34,16 +34,15 @@
 #include <dbot/camera_data.h>
 #include <dbot/filter/rao_blackwell_coordinate_particle_filter.h>
 #include <dbot/object_model.h>
-#include <dbrt/tracker/robot_tracker.h>
+#include <dbrt/tracker/depth_tracker.h>
 #include <fl/model/transition/interface/transition_function.hpp>
-#include <image_transport/image_transport.h>
 
 namespace dbrt
 {
 /**
  * \brief VisualTracker
  */
-class VisualTracker : public RobotTracker
+class VisualTracker : public DepthTracker
 {
 public:
     typedef fl::TransitionFunction<State, Noise, Input> Transition;
@@ -86,6 +85,32 @@ public:
      */
     void initialize(const std::vector<State>& initial_states);
 
+    /**
+     * \brief Initializes the particle filter with the given initial states
+     *    using the given number of evaluations instead of the configured one
+     */
+    void initialize(const std::vector<State>& initial_states,
+                    int evaluation_count);
+
+    /**
+     * \brief Configured number of likelihood evaluations per filter step
+     */
+    int evaluation_count() const;
+
+    /**
+     * \brief Sets the transition noise to the prior standard deviation and
+     *     initializes the particles at the prior mean using the given
+     *     fraction of the configured evaluations
+     */
+    void set_prior(const State& mean,
+                   const Eigen::VectorXd& std_diagonal,
+                   double effort);
+
+    /**
+     * \brief Covariance of the particle belief
+     */
+    Eigen::MatrixXd covariance();
+
     const std::shared_ptr<Filter> filter();
 
 private:
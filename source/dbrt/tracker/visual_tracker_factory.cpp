@@ -30,38 +30,39 @@
 
 #include <dbot/builder/rb_sensor_builder.h>
 #include <dbot_ros/util/ros_interface.h>
+#include <dbrt/builder/pyramid_sensor_builder.h>
+#include <dbrt/builder/sdf_sensor_builder.h>
+#include <dbrt/builder/surface_point_sensor_builder.h>
+#include <dbrt/builder/tile_raster_sensor_builder.h>
 #include <dbrt/builder/visual_tracker_builder.h>
 #include <dbrt/tracker/visual_tracker_factory.h>
 #include <dbrt/urdf_object_loader.h>
+#include <dbrt/util/message_conversion.h>
 #include <dbrt/util/parameter_tools.h>
+#include <algorithm>
+#include <cmath>
 
 namespace dbrt
 {
 /**
- * \brief Create a particle filter tracking the robot joints based on depth
- *     images measurements
- * \param prefix
- *     parameter prefix, e.g. fusion_tracker
- * \param kinematics
- *     URDF robot kinematics
+ * \brief Builds the visual tracker for the given sampling blocks and
+ *     transition noise. Joints listed in fixed_joints are not sampled.
  */
-std::shared_ptr<dbrt::VisualTracker> create_visual_tracker(
+std::shared_ptr<dbrt::VisualTracker> build_visual_tracker(
     std::string prefix,
     std::shared_ptr<KinematicsFromURDF> kinematics,
     std::shared_ptr<dbot::CameraData> camera_data,
-    sensor_msgs::JointState::ConstPtr joint_state)
+    sensor_msgs::JointState::ConstPtr joint_state,
+    const SamplingBlocksDefinition& sampling_blocks_definition,
+    const std::map<std::string, double>& transition_joint_sigmas_map,
+    const std::vector<int>& fixed_joints,
+    int sample_count)
 {
     ros::NodeHandle nh("~");
 
     typedef dbrt::VisualTracker Tracker;
     typedef Tracker::State State;
 
-    bool estimate_camera_offset =
-        ri::read<bool>("camera_offset/estimate_camera_offset", nh);
-
-    auto camera_transition_joint_sigmas_map = read_maps_from_map_list(
-        "camera_offset/joint_transition/joint_sigmas", nh);
-
     /* ------------------------------ */
     /* - Create the robot model     - */
     /* ------------------------------ */
@@ -79,15 +80,6 @@ std::shared_ptr<dbrt::VisualTracker> create_visual_tracker(
     /* ------------------------------ */
     dbrt::TransitionBuilder<Tracker>::Parameters transition_parameters;
 
-    auto transition_joint_sigmas_map =
-        read_maps_from_map_list(prefix + "joint_transition/joint_sigmas", nh);
-    if (estimate_camera_offset)
-    {
-       insert_map_with_prefixed_keys(camera_transition_joint_sigmas_map, 
-                                     kinematics->camera_frame_id() + "_", 
-                                     transition_joint_sigmas_map);
-    }
-
     // linear state transition parameters
     transition_parameters.joint_sigmas =
         extract_ordered_values(transition_joint_sigmas_map, kinematics);
@@ -120,6 +112,11 @@ std::shared_ptr<dbrt::VisualTracker> create_visual_tracker(
             ri::read<int>(prefix + "cpu/sample_count", nh);
     }
 
+    if (sample_count > 0)
+    {
+        sensor_parameters.sample_count = sample_count;
+    }
+
     sensor_parameters.occlusion.p_occluded_visible = ri::read<double>(
         prefix + "observation/occlusion/p_occluded_visible", nh);
     sensor_parameters.occlusion.p_occluded_occluded = ri::read<double>(
@@ -146,8 +143,169 @@ std::shared_ptr<dbrt::VisualTracker> create_visual_tracker(
     sensor_parameters.geometry_shader_file =
         ri::read<std::string>(prefix + "gpu/geometry_shader_file", nh);
 
-    auto sensor_builder = std::make_shared<dbot::RbSensorBuilder<State>>(
-        object_model, camera_data, sensor_parameters);
+    // Kinect pixel model of the sensors scoring without the renderer, using
+    // the kinect and occlusion parameters above. Optionally tabulated.
+    dbrt::KinectPixelModel::Parameters kinect_parameters;
+    kinect_parameters.tail_weight = sensor_parameters.kinect.tail_weight;
+    kinect_parameters.model_sigma = sensor_parameters.kinect.model_sigma;
+    kinect_parameters.sigma_factor = sensor_parameters.kinect.sigma_factor;
+    kinect_parameters.occlusion_probability =
+        sensor_parameters.occlusion.initial_occlusion_prob;
+    kinect_parameters.exponential_rate = -std::log(0.5);
+    kinect_parameters.max_depth =
+        nh.param<double>(prefix + "observation/kinect_table/max_depth", 6.);
+
+    std::shared_ptr<const dbrt::KinectLoglikeTable> kinect_table;
+    if (nh.param<bool>(prefix + "observation/kinect_table/enabled", false))
+    {
+        dbrt::KinectLoglikeTable::Parameters table_parameters;
+        table_parameters.min_depth = nh.param<double>(
+            prefix + "observation/kinect_table/min_depth", 0.3);
+        table_parameters.max_depth = kinect_parameters.max_depth;
+        table_parameters.depth_step = nh.param<double>(
+            prefix + "observation/kinect_table/depth_step", 0.01);
+        table_parameters.residual_range = nh.param<double>(
+            prefix + "observation/kinect_table/residual_range", 8.);
+        table_parameters.residual_step = nh.param<double>(
+            prefix + "observation/kinect_table/residual_step", 0.1);
+
+        kinect_table = std::make_shared<dbrt::KinectLoglikeTable>(
+            dbrt::KinectPixelModel(kinect_parameters), table_parameters);
+        ROS_INFO("Kinect log-likelihood table with %d entries, maximum "
+                 "error %g",
+                 kinect_table->size(),
+                 kinect_table->max_error());
+    }
+
+    // the rendering based sensor, or one of the sensors scoring without
+    // the GPU. The sensors whose log-likelihoods are sums over pixels may be
+    // evaluated on an image pyramid.
+    std::shared_ptr<dbot::RbSensorBuilder<State>> sensor_builder;
+    dbrt::PyramidSensorBuilder::LevelFactory create_level;
+    auto sensor_model =
+        nh.param<std::string>(prefix + "observation/model", "renderer");
+    if (sensor_model == "renderer")
+    {
+        sensor_builder = std::make_shared<dbot::RbSensorBuilder<State>>(
+            object_model, camera_data, sensor_parameters);
+    }
+    else if (sensor_model == "sdf")
+    {
+        dbrt::SdfSensorBuilder::Parameters sdf_parameters;
+        sdf_parameters.voxel_size =
+            nh.param<double>(prefix + "observation/sdf/voxel_size", 0.004);
+        sdf_parameters.truncation =
+            nh.param<double>(prefix + "observation/sdf/truncation", 0.03);
+        sdf_parameters.cache_file =
+            nh.param<std::string>(prefix + "observation/sdf/cache_file", "");
+        sdf_parameters.sensor.distance_sigma = nh.param<double>(
+            prefix + "observation/sdf/distance_sigma", 0.01);
+        sdf_parameters.sensor.tail_weight =
+            nh.param<double>(prefix + "observation/sdf/tail_weight", 0.01);
+        sdf_parameters.sensor.free_space_penalty = nh.param<double>(
+            prefix + "observation/sdf/free_space_penalty", 1.);
+        // stratified subset of the pixels within the robot region
+        sdf_parameters.sensor.subset_count =
+            nh.param<int>(prefix + "observation/sdf/subset_count", 0);
+        sdf_parameters.sensor.subset_fraction = nh.param<double>(
+            prefix + "observation/sdf/subset_fraction", 0.);
+
+        auto sdf_sensor_builder =
+            std::make_shared<dbrt::SdfSensorBuilder>(kinematics,
+                                                     object_model,
+                                                     camera_data,
+                                                     sensor_parameters,
+                                                     sdf_parameters);
+        sensor_builder = sdf_sensor_builder;
+        create_level = [sdf_sensor_builder](
+            const dbrt::CameraGeometry& camera_geometry) {
+            return sdf_sensor_builder->build(camera_geometry);
+        };
+    }
+    else if (sensor_model == "surface_points")
+    {
+        dbrt::SurfacePointSensorBuilder::Parameters surface_point_parameters;
+        surface_point_parameters.points_per_link = nh.param<int>(
+            prefix + "observation/surface_points/points_per_link", 300);
+        surface_point_parameters.depth_sigma = nh.param<double>(
+            prefix + "observation/surface_points/depth_sigma", 0.01);
+        surface_point_parameters.tail_weight = nh.param<double>(
+            prefix + "observation/surface_points/tail_weight", 0.01);
+        surface_point_parameters.occlusion_weight = nh.param<double>(
+            prefix + "observation/surface_points/occlusion_weight", 0.3);
+        // link contributions cached by pose while sampling the blocks
+        surface_point_parameters.link_cache_size = nh.param<int>(
+            prefix + "observation/surface_points/link_cache_size", 0);
+
+        auto surface_point_sensor_builder =
+            std::make_shared<dbrt::SurfacePointSensorBuilder>(
+                kinematics,
+                object_model,
+                camera_data,
+                sensor_parameters,
+                surface_point_parameters,
+                kinect_table);
+        // scores a fixed number of points at any resolution, hence there is
+        // neither a pixel ratio between levels nor a saving on coarse levels
+        sensor_builder = surface_point_sensor_builder;
+    }
+    else if (sensor_model == "raster")
+    {
+        // rasterizes the link meshes tile by tile and scores each tile
+        // right away instead of rendering full depth images
+        dbrt::TileRasterSensorBuilder::Parameters tile_raster_parameters;
+        tile_raster_parameters.tile_size =
+            nh.param<int>(prefix + "observation/raster/tile_size", 32);
+        tile_raster_parameters.kinect = kinect_parameters;
+
+        auto tile_raster_sensor_builder =
+            std::make_shared<dbrt::TileRasterSensorBuilder>(
+                kinematics,
+                object_model,
+                camera_data,
+                sensor_parameters,
+                tile_raster_parameters,
+                kinect_table);
+        sensor_builder = tile_raster_sensor_builder;
+        create_level = [tile_raster_sensor_builder](
+            const dbrt::CameraGeometry& camera_geometry) {
+            return tile_raster_sensor_builder->build(camera_geometry);
+        };
+    }
+    else
+    {
+        ROS_ERROR("Unknown observation model %s", sensor_model.c_str());
+        exit(-1);
+    }
+
+    const int pyramid_levels =
+        nh.param<int>(prefix + "observation/pyramid/levels", 1);
+    if (pyramid_levels > 1)
+    {
+        if (!create_level)
+        {
+            ROS_ERROR("The image pyramid is not supported by the %s "
+                      "observation model",
+                      sensor_model.c_str());
+            exit(-1);
+        }
+
+        dbrt::PyramidSensorBuilder::Parameters pyramid_parameters;
+        pyramid_parameters.factor =
+            nh.param<int>(prefix + "observation/pyramid/factor", 2);
+        pyramid_parameters.refine_count =
+            nh.param<int>(prefix + "observation/pyramid/refine_count", 0);
+        pyramid_parameters.refine_margin = nh.param<double>(
+            prefix + "observation/pyramid/refine_margin", 20.);
+
+        sensor_builder =
+            std::make_shared<dbrt::PyramidSensorBuilder>(object_model,
+                                                         camera_data,
+                                                         sensor_parameters,
+                                                         pyramid_levels,
+                                                         pyramid_parameters,
+                                                         create_level);
+    }
 
     ROS_INFO("Observation model created");
 
@@ -162,21 +320,9 @@ std::shared_ptr<dbrt::VisualTracker> create_visual_tracker(
     tracker_parameters.max_kl_divergence =
         ri::read<double>(prefix + "max_kl_divergence", nh);
 
-    auto sampling_blocks_definition =
-        ri::read<SamplingBlocksDefinition>("sampling_blocks", nh);
-
-    auto camera_offset_sampling_blocks_definition =
-        ri::read<SamplingBlocksDefinition>("camera_offset/sampling_blocks", nh);
-
-    if (estimate_camera_offset)
-    {
-        sampling_blocks_definition = merge_sampling_block_definitions(
-	   sampling_blocks_definition,
-           camera_offset_sampling_blocks_definition, kinematics->camera_frame_id() + '_');
-    }
-
     tracker_parameters.sampling_blocks =
         definition_to_sampling_block(sampling_blocks_definition, kinematics);
+    tracker_parameters.fixed_joints = fixed_joints;
 
     auto tracker_builder =
         dbrt::VisualTrackerBuilder<Tracker>(kinematics,
@@ -193,11 +339,135 @@ std::shared_ptr<dbrt::VisualTracker> create_visual_tracker(
     /* ------------------------------ */
 
     std::vector<Eigen::VectorXd> initial_states_vectors = {
-        kinematics->sensor_msg_to_eigen(*joint_state)};
+        joint_state_to_eigen(kinematics, *joint_state)};
     std::vector<dbrt::RobotState<>> initial_states;
     for (auto state : initial_states_vectors) initial_states.push_back(state);
     tracker->initialize(initial_states);
 
     return tracker;
 }
+
+/**
+ * \brief Create a particle filter tracking the robot joints based on depth
+ *     images measurements
+ * \param prefix
+ *     parameter prefix, e.g. fusion_tracker
+ * \param kinematics
+ *     URDF robot kinematics
+ */
+std::shared_ptr<dbrt::VisualTracker> create_visual_tracker(
+    std::string prefix,
+    std::shared_ptr<KinematicsFromURDF> kinematics,
+    std::shared_ptr<dbot::CameraData> camera_data,
+    sensor_msgs::JointState::ConstPtr joint_state)
+{
+    ros::NodeHandle nh("~");
+
+    bool estimate_camera_offset =
+        ri::read<bool>("camera_offset/estimate_camera_offset", nh);
+    bool decoupled_camera_offset =
+        estimate_camera_offset &&
+        nh.param<bool>("camera_offset/decoupled", false);
+
+    auto camera_transition_joint_sigmas_map = read_maps_from_map_list(
+        "camera_offset/joint_transition/joint_sigmas", nh);
+
+    auto transition_joint_sigmas_map =
+        read_maps_from_map_list(prefix + "joint_transition/joint_sigmas", nh);
+
+    auto sampling_blocks_definition =
+        ri::read<SamplingBlocksDefinition>("sampling_blocks", nh);
+
+    auto camera_offset_sampling_blocks_definition =
+        ri::read<SamplingBlocksDefinition>("camera_offset/sampling_blocks", nh);
+
+    std::vector<int> fixed_joints;
+
+    if (decoupled_camera_offset)
+    {
+        // the offset is estimated by a separate low-rate tracker. Here the
+        // offset joints are neither sampled nor diffused.
+        for (auto& entry : camera_transition_joint_sigmas_map)
+        {
+            entry.second = 0.;
+        }
+        fixed_joints = kinematics->camera_offset_joint_indices();
+    }
+    else if (estimate_camera_offset)
+    {
+        sampling_blocks_definition = merge_sampling_block_definitions(
+            sampling_blocks_definition,
+            camera_offset_sampling_blocks_definition,
+            kinematics->camera_frame_id() + '_');
+    }
+
+    if (estimate_camera_offset)
+    {
+        insert_map_with_prefixed_keys(camera_transition_joint_sigmas_map,
+                                      kinematics->camera_frame_id() + "_",
+                                      transition_joint_sigmas_map);
+    }
+
+    return build_visual_tracker(prefix,
+                                kinematics,
+                                camera_data,
+                                joint_state,
+                                sampling_blocks_definition,
+                                transition_joint_sigmas_map,
+                                fixed_joints,
+                                0);
+}
+
+std::shared_ptr<dbrt::VisualTracker> create_camera_offset_tracker(
+    std::string prefix,
+    std::shared_ptr<KinematicsFromURDF> kinematics,
+    std::shared_ptr<dbot::CameraData> camera_data,
+    sensor_msgs::JointState::ConstPtr joint_state)
+{
+    ros::NodeHandle nh("~");
+
+    auto camera_transition_joint_sigmas_map = read_maps_from_map_list(
+        "camera_offset/joint_transition/joint_sigmas", nh);
+
+    auto transition_joint_sigmas_map =
+        read_maps_from_map_list(prefix + "joint_transition/joint_sigmas", nh);
+
+    auto camera_offset_sampling_blocks_definition =
+        ri::read<SamplingBlocksDefinition>("camera_offset/sampling_blocks", nh);
+
+    // robot joints are held fixed at the state provided by the main tracker
+    for (auto& entry : transition_joint_sigmas_map)
+    {
+        entry.second = 0.;
+    }
+    insert_map_with_prefixed_keys(camera_transition_joint_sigmas_map,
+                                  kinematics->camera_frame_id() + "_",
+                                  transition_joint_sigmas_map);
+
+    auto sampling_blocks_definition = merge_sampling_block_definitions(
+        SamplingBlocksDefinition(),
+        camera_offset_sampling_blocks_definition,
+        kinematics->camera_frame_id() + '_');
+
+    auto offset_joints = kinematics->camera_offset_joint_indices();
+    std::vector<int> fixed_joints;
+    for (int i = 0; i < kinematics->num_joints(); ++i)
+    {
+        if (std::find(offset_joints.begin(), offset_joints.end(), i) ==
+            offset_joints.end())
+        {
+            fixed_joints.push_back(i);
+        }
+    }
+
+    return build_visual_tracker(
+        prefix,
+        kinematics,
+        camera_data,
+        joint_state,
+        sampling_blocks_definition,
+        transition_joint_sigmas_map,
+        fixed_joints,
+        nh.param<int>("camera_offset/sample_count", 0));
+}
 }
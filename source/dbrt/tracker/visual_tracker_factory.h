@@ -51,4 +51,19 @@ std::shared_ptr<dbrt::VisualTracker> create_visual_tracker(
     std::shared_ptr<KinematicsFromURDF> urdf_kinematics,
     std::shared_ptr<dbot::CameraData> camera_data,
     sensor_msgs::JointState::ConstPtr joint_state);
+
+/**
+ * \brief Create a particle filter estimating only the camera offset joints
+ *     based on depth images. All robot joints are kept fixed at the state the
+ *     tracker is initialized with.
+ * \param prefix
+ *     parameter prefix, e.g. fusion_tracker
+ * \param urdf_kinematics
+ *     URDF robot kinematics with injected camera offset joints
+ */
+std::shared_ptr<dbrt::VisualTracker> create_camera_offset_tracker(
+    std::string prefix,
+    std::shared_ptr<KinematicsFromURDF> urdf_kinematics,
+    std::shared_ptr<dbot::CameraData> camera_data,
+    sensor_msgs::JointState::ConstPtr joint_state);
 }
@@ -17,8 +17,9 @@
  * \author Jan Issac (jan.issac@gmail.com)
  */
 
-#include <dbot_ros/util/ros_interface.h>
 #include <dbrt/tracker/visual_tracker_ros.h>
+#include <dbrt/util/depth_image.h>
+#include <dbrt/util/message_conversion.h>
 
 namespace dbrt
 {
@@ -34,10 +35,12 @@ VisualTrackerRos::VisualTrackerRos(
 
 void VisualTrackerRos::track(const sensor_msgs::Image& ros_image)
 {
-    auto image = ri::to_eigen_vector<typename Obsrv::Scalar>(
-        ros_image, camera_data_->downsampling_factor());
+    DepthImageView image;
+    if (!to_depth_image_view(ros_image, image)) return;
 
-    current_state_ = tracker_->track(image);
+    depth_image_to_obsrv(image, camera_data_->downsampling_factor(), obsrv_);
+
+    current_state_ = tracker_->track(obsrv_);
     current_time_ = ros_image.header.stamp;
     // current_pose_.pose = ri::to_ros_pose(current_state_);
     // current_pose_.header.stamp = ros_image.header.stamp;
@@ -46,8 +49,13 @@ void VisualTrackerRos::track(const sensor_msgs::Image& ros_image)
 
 void VisualTrackerRos::update_obsrv(const sensor_msgs::Image& ros_image)
 {
+    DepthImageView image;
+    if (!to_depth_image_view(ros_image, image)) return;
+
     std::lock_guard<std::mutex> lock_obsrv(obsrv_mutex_);
-    current_ros_image_ = ros_image;
+    depth_image_to_obsrv(
+        image, camera_data_->downsampling_factor(), current_obsrv_);
+    current_obsrv_time_ = ros_image.header.stamp;
     obsrv_updated_ = true;
 }
 
@@ -76,14 +84,16 @@ bool VisualTrackerRos::process()
 {
     if (!obsrv_updated_) return false;
 
-    Obsrv obsrv;
-    sensor_msgs::Image ros_image;
+    ros::Time obsrv_time;
     {
         std::lock_guard<std::mutex> lock_obsrv(obsrv_mutex_);
-        ros_image = current_ros_image_;
+        obsrv_.swap(current_obsrv_);
+        obsrv_time = current_obsrv_time_;
         obsrv_updated_ = false;
     }
-    track(ros_image);
+
+    current_state_ = tracker_->track(obsrv_);
+    current_time_ = obsrv_time;
 
     return true;
 }
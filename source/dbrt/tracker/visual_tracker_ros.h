@@ -23,6 +23,7 @@
 #include <mutex>
 #include <dbrt/tracker/visual_tracker.h>
 #include <ros/time.h>
+#include <sensor_msgs/Image.h>
 
 namespace dbrt
 {
@@ -66,7 +67,11 @@ protected:
     bool running_;
     State current_state_;
     ros::Time current_time_;
-    sensor_msgs::Image current_ros_image_;
+    // latest converted observation and its time stamp, swapped with obsrv_
+    // for processing
+    Obsrv current_obsrv_;
+    ros::Time current_obsrv_time_;
+    Obsrv obsrv_;
     std::mutex obsrv_mutex_;
     std::mutex state_mutex_;
     std::shared_ptr<VisualTracker> tracker_;
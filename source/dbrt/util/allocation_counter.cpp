@@ -0,0 +1,108 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file allocation_counter.cpp
+ * \date October 2026
+ */
+
+#include <dbrt/util/allocation_counter.h>
+
+#ifdef DBRT_COUNT_ALLOCATIONS
+
+#include <cstddef>
+
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* pointer, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+}
+
+namespace
+{
+// initial-exec TLS does not allocate on first access, hence it is safe to
+// use within malloc
+__thread std::uint64_t allocation_count
+    __attribute__((tls_model("initial-exec"))) = 0;
+}
+
+// operator new and Eigen's aligned allocation both end up here
+extern "C" void* malloc(std::size_t size)
+{
+    ++allocation_count;
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t count, std::size_t size)
+{
+    ++allocation_count;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* pointer, std::size_t size)
+{
+    ++allocation_count;
+    return __libc_realloc(pointer, size);
+}
+
+extern "C" void* memalign(std::size_t alignment, std::size_t size)
+{
+    ++allocation_count;
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" void* aligned_alloc(std::size_t alignment, std::size_t size)
+{
+    ++allocation_count;
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void** pointer,
+                              std::size_t alignment,
+                              std::size_t size)
+{
+    ++allocation_count;
+    *pointer = __libc_memalign(alignment, size);
+    return *pointer || size == 0 ? 0 : 12;  // ENOMEM
+}
+
+namespace dbrt
+{
+bool allocation_counting_enabled()
+{
+    return true;
+}
+
+std::uint64_t thread_allocation_count()
+{
+    return allocation_count;
+}
+}
+
+#else
+
+namespace dbrt
+{
+bool allocation_counting_enabled()
+{
+    return false;
+}
+
+std::uint64_t thread_allocation_count()
+{
+    return 0;
+}
+}
+
+#endif
@@ -0,0 +1,39 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file allocation_counter.h
+ * \date October 2026
+ *
+ * Per thread heap allocation counting used to verify that the real-time
+ * paths do not allocate. Counting requires building with
+ * DBRT_COUNT_ALLOCATIONS, which replaces malloc and friends for the whole
+ * process (glibc only). Otherwise all counts remain 0.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace dbrt
+{
+/**
+ * \brief Returns true if the build counts allocations
+ */
+bool allocation_counting_enabled();
+
+/**
+ * \brief Number of heap allocations performed by the calling thread so far
+ */
+std::uint64_t thread_allocation_count();
+}
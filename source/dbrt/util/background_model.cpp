@@ -0,0 +1,165 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file background_model.cpp
+ * \date October 2026
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <dbrt/util/background_model.h>
+#include <fstream>
+#include <limits>
+
+namespace dbrt
+{
+namespace
+{
+const char file_magic[8] = {'D', 'B', 'R', 'T', 'B', 'G', 'M', '1'};
+}
+
+BackgroundModel::BackgroundModel(int width,
+                                 int height,
+                                 const Parameters& parameters)
+    : width_(width),
+      height_(height),
+      parameters_(parameters),
+      learned_images_(0),
+      mean_(Eigen::ArrayXf::Zero(width * height)),
+      variance_(Eigen::ArrayXf::Zero(width * height)),
+      count_(Eigen::ArrayXi::Zero(width * height)),
+      keep_(width * height, 0)
+{
+}
+
+void BackgroundModel::learn(const Image& image)
+{
+    assert(image.size() == mean_.size());
+
+    const int max_count = std::numeric_limits<int>::max() - 1;
+    for (int i = 0; i < image.size(); ++i)
+    {
+        const float depth = image(i);
+        if (!std::isfinite(depth)) continue;
+
+        count_(i) = std::min(count_(i), max_count) + 1;
+        const float weight = std::max(1.f / count_(i),
+                                      float(parameters_.learning_rate));
+        const float delta = depth - mean_(i);
+        mean_(i) += weight * delta;
+        variance_(i) =
+            (1.f - weight) * (variance_(i) + weight * delta * delta);
+    }
+    learned_images_++;
+}
+
+int BackgroundModel::mask(const std::vector<PixelRoi>& keep, Image& image)
+{
+    assert(image.size() == mean_.size());
+
+    for (const PixelRoi& roi : keep)
+    {
+        for (int v = roi.v_min; v <= roi.v_max; ++v)
+        {
+            std::fill(keep_.begin() + v * width_ + roi.u_min,
+                      keep_.begin() + v * width_ + roi.u_max + 1,
+                      1);
+        }
+    }
+
+    const float invalid = std::numeric_limits<float>::quiet_NaN();
+    const float noise_sigma = parameters_.noise_sigma;
+    const float noise_sigma_quadratic = parameters_.noise_sigma_quadratic;
+    const float match_factor_sq =
+        parameters_.match_factor * parameters_.match_factor;
+
+    int masked = 0;
+    for (int i = 0; i < image.size(); ++i)
+    {
+        if (keep_[i])
+        {
+            keep_[i] = 0;
+            continue;
+        }
+
+        const float depth = image(i);
+        if (count_(i) < parameters_.min_samples || !std::isfinite(depth))
+        {
+            continue;
+        }
+
+        const float sigma = noise_sigma + noise_sigma_quadratic * depth * depth;
+        const float delta = depth - mean_(i);
+        if (delta * delta <=
+            match_factor_sq * (variance_(i) + sigma * sigma))
+        {
+            image(i) = invalid;
+            masked++;
+        }
+    }
+
+    return masked;
+}
+
+bool BackgroundModel::write(const std::string& file) const
+{
+    std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+    stream.write(file_magic, sizeof(file_magic));
+    stream.write(reinterpret_cast<const char*>(&width_), sizeof(int));
+    stream.write(reinterpret_cast<const char*>(&height_), sizeof(int));
+    stream.write(reinterpret_cast<const char*>(mean_.data()),
+                 mean_.size() * sizeof(float));
+    stream.write(reinterpret_cast<const char*>(variance_.data()),
+                 variance_.size() * sizeof(float));
+    stream.write(reinterpret_cast<const char*>(count_.data()),
+                 count_.size() * sizeof(int));
+    return bool(stream);
+}
+
+bool BackgroundModel::read(const std::string& file)
+{
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream) return false;
+
+    char magic[sizeof(file_magic)];
+    int width = 0;
+    int height = 0;
+    stream.read(magic, sizeof(magic));
+    stream.read(reinterpret_cast<char*>(&width), sizeof(int));
+    stream.read(reinterpret_cast<char*>(&height), sizeof(int));
+    if (!stream || std::memcmp(magic, file_magic, sizeof(magic)) != 0 ||
+        width != width_ || height != height_)
+    {
+        return false;
+    }
+
+    Eigen::ArrayXf mean(mean_.size());
+    Eigen::ArrayXf variance(variance_.size());
+    Eigen::ArrayXi count(count_.size());
+    stream.read(reinterpret_cast<char*>(mean.data()),
+                mean.size() * sizeof(float));
+    stream.read(reinterpret_cast<char*>(variance.data()),
+                variance.size() * sizeof(float));
+    stream.read(reinterpret_cast<char*>(count.data()),
+                count.size() * sizeof(int));
+    if (!stream) return false;
+
+    mean_.swap(mean);
+    variance_.swap(variance);
+    count_.swap(count);
+    return true;
+}
+}
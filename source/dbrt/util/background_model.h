@@ -0,0 +1,102 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file background_model.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <dbrt/util/camera_geometry.h>
+#include <fl/util/types.hpp>
+#include <string>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Per-pixel running depth statistic of the static scene.
+ *
+ * Each pixel keeps an exponentially weighted mean and variance of its valid
+ * depth measurements. A measurement matches the background if it lies within
+ * match_factor standard deviations, where the variance of the statistic is
+ * combined with the depth noise sigma(d) = noise_sigma +
+ * noise_sigma_quadratic * d^2. Pixels with fewer than min_samples
+ * measurements never match.
+ *
+ * The model is learned from images in which the robot is out of view, or
+ * read from a previously captured reference file.
+ */
+class BackgroundModel
+{
+public:
+    typedef Eigen::Matrix<fl::Real, Eigen::Dynamic, 1> Image;
+
+    struct Parameters
+    {
+        // lower bound of the weight of a new measurement. The first
+        // measurements are averaged uniformly.
+        double learning_rate;
+        int min_samples;
+        double noise_sigma;
+        double noise_sigma_quadratic;
+        double match_factor;
+    };
+
+public:
+    BackgroundModel(int width, int height, const Parameters& parameters);
+
+    /**
+     * \brief Adds all valid pixels of the image to the statistic
+     */
+    void learn(const Image& image);
+
+    /**
+     * \brief Invalidates, i.e. sets to NaN, all pixels which match the
+     *     background and do not lie within any of the given regions.
+     *     Does not allocate.
+     *
+     * \return number of invalidated pixels
+     */
+    int mask(const std::vector<PixelRoi>& keep, Image& image);
+
+    /**
+     * \brief Number of learned images
+     */
+    int learned_images() const { return learned_images_; }
+
+    /**
+     * \brief Writes the statistic to a binary file. Returns false on failure.
+     */
+    bool write(const std::string& file) const;
+
+    /**
+     * \brief Reads a statistic written by write(). Returns false if the file
+     *     cannot be read or has been written for another resolution.
+     */
+    bool read(const std::string& file);
+
+private:
+    int width_;
+    int height_;
+    Parameters parameters_;
+    int learned_images_;
+    Eigen::ArrayXf mean_;
+    Eigen::ArrayXf variance_;
+    Eigen::ArrayXi count_;
+    // pixels within the regions to keep, reset after each mask()
+    std::vector<char> keep_;
+};
+}
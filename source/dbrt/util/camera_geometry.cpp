@@ -0,0 +1,106 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file camera_geometry.cpp
+ * \date October 2026
+ */
+
+#include <cassert>
+#include <cmath>
+#include <dbrt/util/camera_geometry.h>
+
+namespace dbrt
+{
+CameraGeometry::CameraGeometry(const Eigen::Matrix3d& camera_matrix,
+                               int width,
+                               int height)
+    : width_(width),
+      height_(height),
+      fx_(camera_matrix(0, 0)),
+      fy_(camera_matrix(1, 1)),
+      cx_(camera_matrix(0, 2)),
+      cy_(camera_matrix(1, 2)),
+      ray_x_(width * height),
+      ray_y_(width * height)
+{
+    for (int v = 0; v < height_; ++v)
+    {
+        for (int u = 0; u < width_; ++u)
+        {
+            ray_x_(v * width_ + u) = (u - cx_) / fx_;
+            ray_y_(v * width_ + u) = (v - cy_) / fy_;
+        }
+    }
+}
+
+CameraGeometry::CameraGeometry(const dbot::CameraData& camera_data)
+    : CameraGeometry(camera_data.camera_matrix(),
+                     camera_data.resolution().width,
+                     camera_data.resolution().height)
+{
+}
+
+CameraGeometry CameraGeometry::downsampled(int factor) const
+{
+    // pixel u of the downsampled image is pixel factor * u of this image
+    Eigen::Matrix3d camera_matrix = Eigen::Matrix3d::Identity();
+    camera_matrix(0, 0) = fx_ / factor;
+    camera_matrix(1, 1) = fy_ / factor;
+    camera_matrix(0, 2) = cx_ / factor;
+    camera_matrix(1, 2) = cy_ / factor;
+
+    return CameraGeometry(camera_matrix, width_ / factor, height_ / factor);
+}
+
+PixelRoi CameraGeometry::project_sphere(const Eigen::Vector3f& center,
+                                       float radius) const
+{
+    const PixelRoi image = {0, 0, width_ - 1, height_ - 1};
+
+    // the projection of the sphere lies within the projection of its
+    // bounding box, whose extremes are attained at the corners
+    const float near = center.z() - radius;
+    const float far = center.z() + radius;
+    if (near <= 1e-3f) return image;
+
+    const float x[2] = {center.x() - radius, center.x() + radius};
+    const float y[2] = {center.y() - radius, center.y() + radius};
+    float u_min = fx_ * x[0] / (x[0] < 0.f ? near : far) + cx_;
+    float u_max = fx_ * x[1] / (x[1] < 0.f ? far : near) + cx_;
+    float v_min = fy_ * y[0] / (y[0] < 0.f ? near : far) + cy_;
+    float v_max = fy_ * y[1] / (y[1] < 0.f ? far : near) + cy_;
+
+    PixelRoi roi;
+    // clipped before the conversion to stay within the range of int. The
+    // image bound comes first such that NaN yields the bound.
+    roi.u_min = int(std::floor(std::max(float(image.u_min), u_min)));
+    roi.v_min = int(std::floor(std::max(float(image.v_min), v_min)));
+    roi.u_max = int(std::ceil(std::min(float(image.u_max), u_max)));
+    roi.v_max = int(std::ceil(std::min(float(image.v_max), v_max)));
+    return roi;
+}
+
+void CameraGeometry::back_project(
+    const Eigen::Matrix<fl::Real, Eigen::Dynamic, 1>& image,
+    PointCloud& cloud) const
+{
+    assert(image.size() == pixels());
+
+    // Eigen arrays are aligned, the products are vectorized. NaN depths
+    // yield NaN points.
+    cloud.z = image.array().cast<float>();
+    cloud.x = cloud.z * ray_x_;
+    cloud.y = cloud.z * ray_y_;
+}
+}
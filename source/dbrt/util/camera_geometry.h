@@ -0,0 +1,160 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file camera_geometry.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <dbot/camera_data.h>
+#include <fl/util/types.hpp>
+
+namespace dbrt
+{
+/**
+ * \brief Back-projected depth image in structure of arrays layout with one
+ *     entry per pixel in row major order. Points of invalid pixels are NaN.
+ */
+struct PointCloud
+{
+    Eigen::ArrayXf x;
+    Eigen::ArrayXf y;
+    Eigen::ArrayXf z;
+
+    int size() const { return z.size(); }
+    bool valid(int i) const { return z(i) == z(i); }
+    Eigen::Vector3f point(int i) const
+    {
+        return Eigen::Vector3f(x(i), y(i), z(i));
+    }
+};
+
+/**
+ * \brief Rectangular pixel region, bounds are inclusive. Empty if the lower
+ *     bounds exceed the upper bounds.
+ */
+struct PixelRoi
+{
+    int u_min;
+    int v_min;
+    int u_max;
+    int v_max;
+
+    static PixelRoi none() { return PixelRoi{0, 0, -1, -1}; }
+    bool empty() const { return u_min > u_max || v_min > v_max; }
+    int area() const
+    {
+        return empty() ? 0 : (u_max - u_min + 1) * (v_max - v_min + 1);
+    }
+
+    /**
+     * \brief Extends the region to contain the other one
+     */
+    void merge(const PixelRoi& other)
+    {
+        if (other.empty()) return;
+        if (empty())
+        {
+            *this = other;
+            return;
+        }
+        u_min = std::min(u_min, other.u_min);
+        v_min = std::min(v_min, other.v_min);
+        u_max = std::max(u_max, other.u_max);
+        v_max = std::max(v_max, other.v_max);
+    }
+};
+
+/**
+ * \brief Pinhole geometry of the (downsampled) depth image.
+ *
+ * The viewing rays of all pixels are computed once. Rays are scaled to unit
+ * depth since depth images hold the z coordinate, i.e. the point of a pixel
+ * is its depth times its ray.
+ */
+class CameraGeometry
+{
+public:
+    CameraGeometry(const Eigen::Matrix3d& camera_matrix, int width, int height);
+
+    /**
+     * \brief Geometry of the downsampled resolution of the camera data
+     */
+    explicit CameraGeometry(const dbot::CameraData& camera_data);
+
+    /**
+     * \brief Geometry of the image keeping every factor-th pixel of every
+     *     factor-th row
+     */
+    CameraGeometry downsampled(int factor) const;
+
+    /**
+     * \brief Back-projects all pixels of the depth image as provided by
+     *     depth_image_to_obsrv(). The point cloud is only reallocated if the
+     *     resolution changes.
+     */
+    void back_project(const Eigen::Matrix<fl::Real, Eigen::Dynamic, 1>& image,
+                      PointCloud& cloud) const;
+
+    /**
+     * \brief Returns the row major index of the pixel the point projects to,
+     *     or -1 if it is behind the camera or outside of the image
+     */
+    int project(const Eigen::Vector3f& point) const
+    {
+        if (!(point.z() > 0.f)) return -1;
+
+        // range checked before the conversion, which also rejects NaN and
+        // values beyond the range of int
+        const float u = std::floor(fx_ * point.x() / point.z() + cx_ + 0.5f);
+        const float v = std::floor(fy_ * point.y() / point.z() + cy_ + 0.5f);
+        if (!(u >= 0.f && u < width_ && v >= 0.f && v < height_)) return -1;
+
+        return int(v) * width_ + int(u);
+    }
+
+    /**
+     * \brief Conservative image region of a sphere given in the camera
+     *     frame, clipped to the image. Spheres reaching behind the image plane
+     *     cover the whole image.
+     */
+    PixelRoi project_sphere(const Eigen::Vector3f& center, float radius) const;
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int pixels() const { return width_ * height_; }
+
+    float fx() const { return fx_; }
+    float fy() const { return fy_; }
+    float cx() const { return cx_; }
+    float cy() const { return cy_; }
+
+    const Eigen::ArrayXf& ray_x() const { return ray_x_; }
+    const Eigen::ArrayXf& ray_y() const { return ray_y_; }
+
+private:
+    int width_;
+    int height_;
+    float fx_;
+    float fy_;
+    float cx_;
+    float cy_;
+    Eigen::ArrayXf ray_x_;
+    Eigen::ArrayXf ray_y_;
+};
+}
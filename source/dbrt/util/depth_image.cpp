@@ -0,0 +1,67 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file depth_image.cpp
+ * \date October 2026
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <dbrt/util/depth_image.h>
+#include <limits>
+
+namespace dbrt
+{
+void depth_image_to_obsrv(const DepthImageView& image,
+                          int downsampling_factor,
+                          Eigen::Matrix<fl::Real, Eigen::Dynamic, 1>& obsrv)
+{
+    const int rows = image.height / downsampling_factor;
+    const int cols = image.width / downsampling_factor;
+    const fl::Real invalid = std::numeric_limits<fl::Real>::quiet_NaN();
+
+    if (obsrv.size() != rows * cols) obsrv.resize(rows * cols);
+
+    for (int row = 0; row < rows; ++row)
+    {
+        const unsigned char* pixels =
+            image.data + std::size_t(row) * downsampling_factor * image.stride;
+
+        switch (image.encoding)
+        {
+            case DepthEncoding::Float32Meters:
+                for (int col = 0; col < cols; ++col)
+                {
+                    float depth;
+                    std::memcpy(&depth,
+                                pixels + col * downsampling_factor * 4,
+                                sizeof(depth));
+                    obsrv(row * cols + col) = depth;
+                }
+                break;
+            case DepthEncoding::UInt16Millimeters:
+                for (int col = 0; col < cols; ++col)
+                {
+                    std::uint16_t depth;
+                    std::memcpy(&depth,
+                                pixels + col * downsampling_factor * 2,
+                                sizeof(depth));
+                    obsrv(row * cols + col) =
+                        depth == 0 ? invalid : fl::Real(depth) * 0.001;
+                }
+                break;
+        }
+    }
+}
+}
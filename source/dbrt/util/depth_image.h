@@ -0,0 +1,62 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file depth_image.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <fl/util/types.hpp>
+
+namespace dbrt
+{
+/**
+ * \brief Pixel formats of depth images
+ */
+enum class DepthEncoding
+{
+    // 32 bit float depth in meters, invalid pixels are NaN
+    Float32Meters,
+    // 16 bit unsigned depth in millimeters, invalid pixels are 0
+    UInt16Millimeters
+};
+
+/**
+ * \brief Non-owning view of a row major depth image
+ */
+struct DepthImageView
+{
+    // capture time stamp in seconds
+    double timestamp;
+    // first byte of the first row
+    const unsigned char* data;
+    int width;
+    int height;
+    // bytes per row including padding
+    int stride;
+    DepthEncoding encoding;
+};
+
+/**
+ * \brief Converts the depth image into a vector of depths in meters
+ *    containing every downsampling_factor-th pixel of every
+ *    downsampling_factor-th row. Invalid pixels are set to NaN. The
+ *    observation is only reallocated if its size changes.
+ */
+void depth_image_to_obsrv(const DepthImageView& image,
+                          int downsampling_factor,
+                          Eigen::Matrix<fl::Real, Eigen::Dynamic, 1>& obsrv);
+}
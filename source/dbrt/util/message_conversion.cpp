@@ -0,0 +1,96 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file message_conversion.cpp
+ * \date October 2026
+ */
+
+#include <dbrt/util/message_conversion.h>
+#include <ros/ros.h>
+#include <sensor_msgs/image_encodings.h>
+
+namespace dbrt
+{
+JointStateConverter::JointStateConverter(
+    const std::shared_ptr<KinematicsFromURDF>& kinematics)
+    : kinematics_(kinematics),
+      joint_values_(Eigen::VectorXd::Zero(kinematics->num_joints()))
+{
+}
+
+const Eigen::VectorXd& JointStateConverter::convert(
+    const sensor_msgs::JointState& joint_state)
+{
+    if (joint_state.name != joint_names_)
+    {
+        joint_names_ = joint_state.name;
+        joint_order_ = kinematics_->get_joint_order(joint_names_);
+    }
+
+    if (joint_state.position.size() != joint_order_.size())
+    {
+        ROS_ERROR_STREAM("Joint state message contains "
+                         << joint_state.position.size()
+                         << " positions for "
+                         << joint_order_.size()
+                         << " joint names.");
+        exit(-1);
+    }
+
+    // unknown joints have been reported by get_joint_order()
+    for (int i = 0; i < joint_order_.size(); ++i)
+    {
+        if (joint_order_[i] < 0) continue;
+        joint_values_(joint_order_[i]) = joint_state.position[i];
+    }
+
+    return joint_values_;
+}
+
+Eigen::VectorXd joint_state_to_eigen(
+    const std::shared_ptr<KinematicsFromURDF>& kinematics,
+    const sensor_msgs::JointState& joint_state)
+{
+    return JointStateConverter(kinematics).convert(joint_state);
+}
+
+bool to_depth_image_view(const sensor_msgs::Image& ros_image,
+                         DepthImageView& image)
+{
+    image.timestamp = ros_image.header.stamp.toSec();
+    image.data = ros_image.data.data();
+    image.width = ros_image.width;
+    image.height = ros_image.height;
+    image.stride = ros_image.step;
+
+    if (ros_image.encoding == sensor_msgs::image_encodings::TYPE_32FC1)
+    {
+        image.encoding = DepthEncoding::Float32Meters;
+    }
+    else if (ros_image.encoding == sensor_msgs::image_encodings::TYPE_16UC1)
+    {
+        image.encoding = DepthEncoding::UInt16Millimeters;
+    }
+    else
+    {
+        ROS_ERROR_STREAM_THROTTLE(1.0,
+                                  "Unsupported depth image encoding '"
+                                      << ros_image.encoding
+                                      << "'. Use 32FC1 or 16UC1.");
+        return false;
+    }
+
+    return true;
+}
+}
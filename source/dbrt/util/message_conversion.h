@@ -0,0 +1,71 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file message_conversion.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <dbrt/kinematics_from_urdf.h>
+#include <dbrt/util/depth_image.h>
+#include <memory>
+#include <sensor_msgs/Image.h>
+#include <sensor_msgs/JointState.h>
+#include <string>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Converts joint state messages into joint values in model order.
+ *     The joint order is computed once and only recomputed if the joint
+ *     names of a message differ from the previous one.
+ */
+class JointStateConverter
+{
+public:
+    explicit JointStateConverter(
+        const std::shared_ptr<KinematicsFromURDF>& kinematics);
+
+    /**
+     * \brief Returns the joint values of the message in model order. The
+     *     camera offset joints are zero. Joints unknown to the model are
+     *     skipped. The returned reference is valid until the next
+     *     conversion.
+     */
+    const Eigen::VectorXd& convert(const sensor_msgs::JointState& joint_state);
+
+private:
+    std::shared_ptr<KinematicsFromURDF> kinematics_;
+    std::vector<std::string> joint_names_;
+    std::vector<int> joint_order_;
+    Eigen::VectorXd joint_values_;
+};
+
+/**
+ * \brief Returns the joint values of the message in model order
+ */
+Eigen::VectorXd joint_state_to_eigen(
+    const std::shared_ptr<KinematicsFromURDF>& kinematics,
+    const sensor_msgs::JointState& joint_state);
+
+/**
+ * \brief Creates a view on the pixel data of the image message. Returns
+ *     false if the encoding is neither 32FC1 nor 16UC1.
+ */
+bool to_depth_image_view(const sensor_msgs::Image& ros_image,
+                         DepthImageView& image);
+}
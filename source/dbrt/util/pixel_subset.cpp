@@ -0,0 +1,58 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file pixel_subset.cpp
+ * \date October 2026
+ */
+
+#include <dbrt/util/pixel_subset.h>
+
+namespace dbrt
+{
+void stratified_pixel_subset(const PointCloud& cloud,
+                             int width,
+                             const PixelRoi& roi,
+                             int count,
+                             std::mt19937& generator,
+                             std::vector<int>& pixels)
+{
+    pixels.clear();
+    if (roi.empty() || count <= 0) return;
+
+    const int attempts = 4;
+    const int cell_size = std::max(
+        int(std::lround(std::sqrt(double(roi.area()) / count))), 1);
+
+    std::uniform_int_distribution<int> offset(0, cell_size - 1);
+    for (int v0 = roi.v_min; v0 <= roi.v_max; v0 += cell_size)
+    {
+        for (int u0 = roi.u_min; u0 <= roi.u_max; u0 += cell_size)
+        {
+            for (int k = 0; k < attempts; ++k)
+            {
+                const int u = u0 + offset(generator);
+                const int v = v0 + offset(generator);
+                if (u > roi.u_max || v > roi.v_max) continue;
+
+                const int pixel = v * width + u;
+                if (cloud.valid(pixel))
+                {
+                    pixels.push_back(pixel);
+                    break;
+                }
+            }
+        }
+    }
+}
+}
@@ -0,0 +1,66 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file pixel_subset.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <dbrt/util/camera_geometry.h>
+#include <random>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Draws about count valid pixels of the point cloud stratified over
+ *     the region. The region is divided into square cells of equal size and
+ *     a random valid pixel is drawn in each cell. Cells without valid pixels
+ *     after a few attempts are left out.
+ *
+ * \param width     image width, i.e. row stride of the point cloud
+ * \param pixels    row major indices of the drawn pixels
+ */
+void stratified_pixel_subset(const PointCloud& cloud,
+                             int width,
+                             const PixelRoi& roi,
+                             int count,
+                             std::mt19937& generator,
+                             std::vector<int>& pixels);
+
+/**
+ * \brief Effective sample size of the weights given by their logarithms,
+ *     i.e. the squared sum over the sum of squares
+ */
+template <typename Array>
+double effective_sample_size(const Array& loglikes)
+{
+    if (loglikes.size() == 0) return 0.;
+
+    const double max = loglikes.maxCoeff();
+    double sum = 0.;
+    double squared_sum = 0.;
+    for (int i = 0; i < loglikes.size(); ++i)
+    {
+        const double weight = std::exp(loglikes(i) - max);
+        sum += weight;
+        squared_sum += weight * weight;
+    }
+    return sum * sum / squared_sum;
+}
+}
@@ -0,0 +1,119 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file rasterizer.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <dbrt/util/camera_geometry.h>
+
+namespace dbrt
+{
+/**
+ * \brief Vertices closer to the camera are not rasterized
+ */
+const float raster_near_plane = 1e-3f;
+
+/**
+ * \brief Triangle corners in image coordinates together with their inverse
+ *     depth
+ */
+struct ScreenTriangle
+{
+    float u[3];
+    float v[3];
+    float inverse_depth[3];
+};
+
+/**
+ * \brief Calls write(u, v, depth) for each pixel center within the triangle
+ *     and the region, consistent with CameraGeometry::project(). Depth is
+ *     interpolated perspective correctly. Both orientations are rasterized,
+ *     degenerate triangles are skipped.
+ */
+template <typename Write>
+inline void rasterize_triangle(const ScreenTriangle& t,
+                               const PixelRoi& region,
+                               Write&& write)
+{
+    const float* u = t.u;
+    const float* v = t.v;
+    const float area =
+        (u[1] - u[0]) * (v[2] - v[0]) - (v[1] - v[0]) * (u[2] - u[0]);
+    if (std::fabs(area) < 1e-12f) return;
+
+    // pixel centers within the bounding box
+    const int u_min = std::max(
+        int(std::ceil(std::min(u[0], std::min(u[1], u[2])))), region.u_min);
+    const int u_max = std::min(
+        int(std::floor(std::max(u[0], std::max(u[1], u[2])))), region.u_max);
+    const int v_min = std::max(
+        int(std::ceil(std::min(v[0], std::min(v[1], v[2])))), region.v_min);
+    const int v_max = std::min(
+        int(std::floor(std::max(v[0], std::max(v[1], v[2])))), region.v_max);
+
+    // barycentric coordinates are the edge functions normalized by the
+    // signed area
+    const float inverse_area = 1.f / area;
+    for (int pv = v_min; pv <= v_max; ++pv)
+    {
+        for (int pu = u_min; pu <= u_max; ++pu)
+        {
+            const float b0 =
+                ((u[2] - u[1]) * (pv - v[1]) - (v[2] - v[1]) * (pu - u[1])) *
+                inverse_area;
+            const float b1 =
+                ((u[0] - u[2]) * (pv - v[2]) - (v[0] - v[2]) * (pu - u[2])) *
+                inverse_area;
+            const float b2 = 1.f - b0 - b1;
+            if (b0 < 0.f || b1 < 0.f || b2 < 0.f) continue;
+
+            // inverse depth is linear in image coordinates
+            write(pu,
+                  pv,
+                  1.f / (b0 * t.inverse_depth[0] + b1 * t.inverse_depth[1] +
+                         b2 * t.inverse_depth[2]));
+        }
+    }
+}
+
+/**
+ * \brief Projects the corners given in the camera frame. Returns false if a
+ *     corner lies in front of the near plane.
+ */
+inline bool project_triangle(const CameraGeometry& camera_geometry,
+                             const Eigen::Vector3f& a,
+                             const Eigen::Vector3f& b,
+                             const Eigen::Vector3f& c,
+                             ScreenTriangle& t)
+{
+    const Eigen::Vector3f* corners[3] = {&a, &b, &c};
+    for (int k = 0; k < 3; ++k)
+    {
+        const Eigen::Vector3f& point = *corners[k];
+        if (point.z() <= raster_near_plane) return false;
+
+        t.inverse_depth[k] = 1.f / point.z();
+        t.u[k] = camera_geometry.fx() * point.x() * t.inverse_depth[k] +
+                 camera_geometry.cx();
+        t.v[k] = camera_geometry.fy() * point.y() * t.inverse_depth[k] +
+                 camera_geometry.cy();
+    }
+    return true;
+}
+}
@@ -0,0 +1,224 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file ring_buffer.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Fixed capacity double ended queue on preallocated slots.
+ *
+ * All slots are created once from a prototype element. Pushing an element
+ * assigns to an existing slot, hence the buffer does not allocate as long as
+ * assigning an element of the prototype's size does not allocate, e.g. for
+ * Eigen vectors of equal size. Removing elements keeps their storage within
+ * the buffer for later reuse.
+ */
+template <typename T>
+class RingBuffer
+{
+public:
+    RingBuffer() : head_(0), size_(0) {}
+
+    RingBuffer(int capacity, const T& prototype)
+        : slots_(capacity, prototype), head_(0), size_(0)
+    {
+    }
+
+    /**
+     * \brief Reallocates all slots. Discards the current content.
+     */
+    void allocate(int capacity, const T& prototype)
+    {
+        slots_.assign(capacity, prototype);
+        head_ = 0;
+        size_ = 0;
+    }
+
+    int size() const { return size_; }
+    int capacity() const { return slots_.size(); }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == capacity(); }
+
+    /**
+     * \brief Element access where 0 is the front and size() - 1 the back
+     */
+    T& operator[](int i) { return slots_[slot(i)]; }
+    const T& operator[](int i) const { return slots_[slot(i)]; }
+
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[size_ - 1]; }
+    const T& back() const { return (*this)[size_ - 1]; }
+
+    /**
+     * \brief Appends a slot at the back and returns it. The slot still holds
+     *     a previously removed element and must be overwritten.
+     */
+    T& push_back()
+    {
+        assert(!full());
+        ++size_;
+        return back();
+    }
+
+    /**
+     * \brief Prepends a slot at the front and returns it. The slot still
+     *     holds a previously removed element and must be overwritten.
+     */
+    T& push_front()
+    {
+        assert(!full());
+        head_ = (head_ + capacity() - 1) % capacity();
+        ++size_;
+        return front();
+    }
+
+    void push_back(const T& element) { push_back() = element; }
+    void push_front(const T& element) { push_front() = element; }
+
+    void pop_front()
+    {
+        assert(!empty());
+        head_ = (head_ + 1) % capacity();
+        --size_;
+    }
+
+    void pop_back()
+    {
+        assert(!empty());
+        --size_;
+    }
+
+    void clear()
+    {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    /**
+     * \brief Removes all elements for which remove(i) returns true, where i
+     *     is the index of the element before removal. The order of the
+     *     remaining elements is preserved. Removed slots are swapped to the
+     *     unused range, i.e. no storage is released.
+     *
+     * \return number of removed elements
+     */
+    template <typename Predicate>
+    int remove_if(Predicate remove)
+    {
+        int kept = 0;
+        for (int i = 0; i < size_; ++i)
+        {
+            if (remove(i)) continue;
+            if (kept != i) std::swap((*this)[kept], (*this)[i]);
+            ++kept;
+        }
+
+        int removed = size_ - kept;
+        size_ = kept;
+        return removed;
+    }
+
+    /**
+     * \brief Exchanges content and slots with another buffer in O(1)
+     */
+    void swap(RingBuffer& other)
+    {
+        slots_.swap(other.slots_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    int slot(int i) const { return (head_ + i) % capacity(); }
+
+private:
+    std::vector<T> slots_;
+    int head_;
+    int size_;
+};
+
+/**
+ * \brief Fixed set of preallocated objects which are handed out by index
+ */
+template <typename T>
+class SlotPool
+{
+public:
+    SlotPool() {}
+
+    SlotPool(int capacity, const T& prototype)
+    {
+        allocate(capacity, prototype);
+    }
+
+    /**
+     * \brief Reallocates all slots. Invalidates all acquired slots.
+     */
+    void allocate(int capacity, const T& prototype)
+    {
+        slots_.assign(capacity, prototype);
+        free_.resize(capacity);
+        for (int i = 0; i < capacity; ++i)
+        {
+            free_[i] = capacity - 1 - i;
+        }
+    }
+
+    /**
+     * \brief Returns the index of an unused slot, or -1 if the pool is
+     *     exhausted
+     */
+    int acquire()
+    {
+        if (free_.empty()) return -1;
+
+        int index = free_.back();
+        free_.pop_back();
+        return index;
+    }
+
+    /**
+     * \brief Returns the slot to the pool. Negative indices are ignored.
+     */
+    void release(int index)
+    {
+        if (index < 0) return;
+
+        assert(free_.size() < slots_.size());
+        free_.push_back(index);
+    }
+
+    int available() const { return free_.size(); }
+    int capacity() const { return slots_.size(); }
+
+    T& operator[](int index) { return slots_[index]; }
+    const T& operator[](int index) const { return slots_[index]; }
+
+private:
+    std::vector<T> slots_;
+    // never exceeds its initial capacity, hence push_back does not allocate
+    std::vector<int> free_;
+};
+}
@@ -0,0 +1,131 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file robot_renderer.cpp
+ * \date October 2026
+ */
+
+#include <algorithm>
+#include <dbrt/robot_state.h>
+#include <dbrt/util/rasterizer.h>
+#include <dbrt/util/robot_renderer.h>
+#include <limits>
+#include <mutex>
+
+namespace dbrt
+{
+RobotRenderer::RobotRenderer(
+    const std::shared_ptr<KinematicsFromURDF>& kinematics,
+    const dbot::ObjectModel& object_model,
+    const CameraGeometry& camera_geometry)
+    : kinematics_(kinematics),
+      camera_geometry_(camera_geometry),
+      depth_(camera_geometry.pixels()),
+      link_ids_(camera_geometry.pixels())
+{
+    const int link_count =
+        std::min(object_model.count_parts(), kinematics->num_links());
+
+    vertices_.resize(link_count);
+    triangles_.resize(link_count);
+    camera_vertices_.resize(link_count);
+    for (int link = 0; link < link_count; ++link)
+    {
+        const auto& vertices = object_model.vertices()[link];
+        vertices_[link].resize(3, vertices.size());
+        for (int i = 0; i < int(vertices.size()); ++i)
+        {
+            vertices_[link].col(i) = vertices[i].cast<float>();
+        }
+        camera_vertices_[link].resize(3, vertices.size());
+
+        for (const auto& triangle : object_model.triangle_indices()[link])
+        {
+            triangles_[link].emplace_back(
+                triangle[0], triangle[1], triangle[2]);
+        }
+    }
+}
+
+void RobotRenderer::render(const Eigen::VectorXd& state)
+{
+    depth_.setConstant(std::numeric_limits<float>::infinity());
+    link_ids_.setConstant(-1);
+
+    {
+        // the kinematics are shared with the robot states
+        std::lock_guard<std::mutex> lock(*RobotState<>::kinematics_mutex_);
+        kinematics_->set_joint_angles(state);
+        for (int link = 0; link < int(vertices_.size()); ++link)
+        {
+            if (vertices_[link].cols() == 0) continue;
+
+            // link to camera transform
+            const Eigen::Matrix3f rotation =
+                kinematics_->get_link_orientation(link)
+                    .toRotationMatrix()
+                    .cast<float>();
+            const Eigen::Vector3f translation =
+                kinematics_->get_link_position(link).cast<float>();
+
+            camera_vertices_[link].noalias() = rotation * vertices_[link];
+            camera_vertices_[link].colwise() += translation;
+        }
+    }
+
+    for (int link = 0; link < int(vertices_.size()); ++link)
+    {
+        rasterize(link);
+    }
+
+    for (int i = 0; i < depth_.size(); ++i)
+    {
+        if (link_ids_(i) < 0)
+        {
+            depth_(i) = std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+}
+
+void RobotRenderer::rasterize(int link)
+{
+    const Eigen::Matrix3Xf& points = camera_vertices_[link];
+    const int width = camera_geometry_.width();
+    const PixelRoi image = {
+        0, 0, camera_geometry_.width() - 1, camera_geometry_.height() - 1};
+
+    ScreenTriangle screen_triangle;
+    for (const Eigen::Vector3i& triangle : triangles_[link])
+    {
+        if (!project_triangle(camera_geometry_,
+                              points.col(triangle(0)),
+                              points.col(triangle(1)),
+                              points.col(triangle(2)),
+                              screen_triangle))
+        {
+            continue;
+        }
+
+        rasterize_triangle(
+            screen_triangle, image, [&](int u, int v, float depth) {
+                const int i = v * width + u;
+                if (depth < depth_(i))
+                {
+                    depth_(i) = depth;
+                    link_ids_(i) = link;
+                }
+            });
+    }
+}
+}
@@ -0,0 +1,85 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file robot_renderer.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <dbot/object_model.h>
+#include <dbrt/kinematics_from_urdf.h>
+#include <dbrt/util/camera_geometry.h>
+#include <memory>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Depth and link index image of the robot at a single joint state.
+ *
+ * Rasterizes the link meshes into a z-buffer on the CPU. Depth is
+ * interpolated perspective correctly and sampled at the pixel centers
+ * consistent with CameraGeometry::project(). Triangles reaching behind the
+ * near plane are skipped. All buffers are allocated on construction.
+ */
+class RobotRenderer
+{
+public:
+    /**
+     * \brief Creates the renderer for the object model parts, one per link
+     *     in kinematics order
+     */
+    RobotRenderer(const std::shared_ptr<KinematicsFromURDF>& kinematics,
+                  const dbot::ObjectModel& object_model,
+                  const CameraGeometry& camera_geometry);
+
+    /**
+     * \brief Renders the robot at the given joint state. Locks the shared
+     *     kinematics.
+     */
+    void render(const Eigen::VectorXd& state);
+
+    /**
+     * \brief Depth in meters of the latest rendering in row major order,
+     *     NaN where no link is visible
+     */
+    const Eigen::ArrayXf& depth() const { return depth_; }
+
+    /**
+     * \brief Index of the visible link of each pixel, -1 where no link is
+     *     visible
+     */
+    const Eigen::ArrayXi& link_ids() const { return link_ids_; }
+
+    const CameraGeometry& camera_geometry() const { return camera_geometry_; }
+
+private:
+    void rasterize(int link);
+
+private:
+    std::shared_ptr<KinematicsFromURDF> kinematics_;
+    CameraGeometry camera_geometry_;
+
+    // link meshes in their link frames and the vertices in the camera frame
+    // of the current rendering
+    std::vector<Eigen::Matrix3Xf> vertices_;
+    std::vector<std::vector<Eigen::Vector3i>> triangles_;
+    std::vector<Eigen::Matrix3Xf> camera_vertices_;
+
+    Eigen::ArrayXf depth_;
+    Eigen::ArrayXi link_ids_;
+};
+}
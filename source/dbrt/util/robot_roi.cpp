@@ -0,0 +1,61 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file robot_roi.cpp
+ * \date October 2026
+ */
+
+#include <dbrt/robot_state.h>
+#include <dbrt/util/robot_roi.h>
+#include <mutex>
+
+namespace dbrt
+{
+void link_rois(KinematicsFromURDF& kinematics,
+               const CameraGeometry& camera_geometry,
+               const Eigen::VectorXd& state,
+               float link_radius,
+               std::vector<PixelRoi>& rois)
+{
+    // the kinematics are shared with the robot states
+    std::lock_guard<std::mutex> lock(*RobotState<>::kinematics_mutex_);
+    kinematics.set_joint_angles(state);
+
+    rois.resize(kinematics.num_links());
+    for (int link = 0; link < kinematics.num_links(); ++link)
+    {
+        const Eigen::Vector3f center =
+            kinematics.get_link_position(link).cast<float>();
+        rois[link] = camera_geometry.project_sphere(center, link_radius);
+    }
+}
+
+PixelRoi robot_roi(KinematicsFromURDF& kinematics,
+                   const CameraGeometry& camera_geometry,
+                   const Eigen::VectorXd& state,
+                   float link_radius)
+{
+    PixelRoi roi = PixelRoi::none();
+
+    std::lock_guard<std::mutex> lock(*RobotState<>::kinematics_mutex_);
+    kinematics.set_joint_angles(state);
+    for (int link = 0; link < kinematics.num_links(); ++link)
+    {
+        const Eigen::Vector3f center =
+            kinematics.get_link_position(link).cast<float>();
+        roi.merge(camera_geometry.project_sphere(center, link_radius));
+    }
+    return roi;
+}
+}
@@ -0,0 +1,46 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file robot_roi.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <dbrt/kinematics_from_urdf.h>
+#include <dbrt/util/camera_geometry.h>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Image regions of spheres with the given radius around the link
+ *     origins at the given joint state, one per link. Locks the shared
+ *     kinematics. Does not allocate once rois holds one entry per link.
+ */
+void link_rois(KinematicsFromURDF& kinematics,
+               const CameraGeometry& camera_geometry,
+               const Eigen::VectorXd& state,
+               float link_radius,
+               std::vector<PixelRoi>& rois);
+
+/**
+ * \brief Union of the link regions, see link_rois()
+ */
+PixelRoi robot_roi(KinematicsFromURDF& kinematics,
+                   const CameraGeometry& camera_geometry,
+                   const Eigen::VectorXd& state,
+                   float link_radius);
+}
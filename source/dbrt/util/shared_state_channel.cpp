@@ -0,0 +1,282 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file shared_state_channel.cpp
+ * \date October 2026
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <dbrt/util/shared_state_channel.h>
+#include <fcntl.h>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dbrt
+{
+namespace
+{
+const std::uint32_t channel_magic = 0x54524244;  // "DBRT"
+const std::uint32_t channel_version = 1;
+
+/**
+ * \brief Slot header. The joint values and the covariance diagonal follow
+ *     directly after it.
+ */
+struct SlotHeader
+{
+    // sequence lock, odd while the slot is being written
+    std::atomic<std::uint64_t> lock;
+    std::uint64_t sequence;
+    double timestamp;
+};
+
+std::size_t slot_size(int joint_count)
+{
+    std::size_t size = sizeof(SlotHeader) + 2 * joint_count * sizeof(double);
+
+    // keep slots on separate cache lines
+    return (size + 63) / 64 * 64;
+}
+
+SlotHeader* slot_at(SharedStateHeader* header, std::uint64_t index)
+{
+    char* slots = reinterpret_cast<char*>(header) + sizeof(SharedStateHeader);
+    return reinterpret_cast<SlotHeader*>(
+        slots + (index % header->capacity) * header->slot_size);
+}
+
+const SlotHeader* slot_at(const SharedStateHeader* header,
+                          std::uint64_t index)
+{
+    return slot_at(const_cast<SharedStateHeader*>(header), index);
+}
+
+std::string shm_name(const std::string& name)
+{
+    return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+
+std::runtime_error shm_error(const std::string& what, const std::string& name)
+{
+    return std::runtime_error(what + " shared memory " + name + ": " +
+                              std::strerror(errno));
+}
+}
+
+SharedStateWriter::SharedStateWriter(const std::string& name,
+                                     int joint_count,
+                                     int capacity)
+    : name_(shm_name(name)),
+      size_(sizeof(SharedStateHeader) + capacity * slot_size(joint_count)),
+      header_(nullptr)
+{
+    if (joint_count <= 0 || capacity <= 0)
+    {
+        throw std::invalid_argument(
+            "Shared state channel requires a positive joint count and "
+            "capacity");
+    }
+
+    int fd = shm_open(name_.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) throw shm_error("Cannot create", name_);
+
+    if (ftruncate(fd, size_) != 0)
+    {
+        close(fd);
+        throw shm_error("Cannot resize", name_);
+    }
+
+    void* memory =
+        mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) throw shm_error("Cannot map", name_);
+
+    // keep the pages resident. Failing to lock only affects the latency of
+    // the first writes.
+    mlock(memory, size_);
+    std::memset(memory, 0, size_);
+
+    header_ = new (memory) SharedStateHeader;
+    header_->version = channel_version;
+    header_->joint_count = joint_count;
+    header_->capacity = capacity;
+    header_->slot_size = slot_size(joint_count);
+    for (int i = 0; i < capacity; ++i)
+    {
+        new (slot_at(header_, i)) SlotHeader;
+        slot_at(header_, i)->lock.store(0, std::memory_order_relaxed);
+    }
+    header_->write_count.store(0, std::memory_order_relaxed);
+
+    // readers check the magic number last
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->magic = channel_magic;
+}
+
+SharedStateWriter::~SharedStateWriter()
+{
+    munmap(header_, size_);
+    shm_unlink(name_.c_str());
+}
+
+void SharedStateWriter::write(double timestamp,
+                              const double* values,
+                              const double* covariance_diagonal)
+{
+    const std::uint64_t count =
+        header_->write_count.load(std::memory_order_relaxed);
+    const std::size_t bytes = header_->joint_count * sizeof(double);
+
+    SlotHeader* slot = slot_at(header_, count);
+    double* data = reinterpret_cast<double*>(slot + 1);
+
+    const std::uint64_t lock = slot->lock.load(std::memory_order_relaxed);
+    slot->lock.store(lock + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->sequence = count;
+    slot->timestamp = timestamp;
+    std::memcpy(data, values, bytes);
+    std::memcpy(data + header_->joint_count, covariance_diagonal, bytes);
+
+    slot->lock.store(lock + 2, std::memory_order_release);
+    header_->write_count.store(count + 1, std::memory_order_release);
+}
+
+int SharedStateWriter::joint_count() const
+{
+    return header_->joint_count;
+}
+
+SharedStateReader::SharedStateReader(const std::string& name)
+    : size_(0), header_(nullptr)
+{
+    const std::string shm = shm_name(name);
+
+    int fd = shm_open(shm.c_str(), O_RDONLY, 0);
+    if (fd < 0) throw shm_error("Cannot open", shm);
+
+    struct stat status;
+    if (fstat(fd, &status) != 0)
+    {
+        close(fd);
+        throw shm_error("Cannot stat", shm);
+    }
+    size_ = status.st_size;
+
+    void* memory = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) throw shm_error("Cannot map", shm);
+
+    header_ = reinterpret_cast<const SharedStateHeader*>(memory);
+
+    if (size_ < sizeof(SharedStateHeader) ||
+        header_->magic != channel_magic ||
+        header_->version != channel_version ||
+        size_ < sizeof(SharedStateHeader) +
+                    header_->capacity * header_->slot_size)
+    {
+        munmap(memory, size_);
+        throw std::runtime_error("Shared memory " + shm +
+                                 " is not a compatible state channel");
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+}
+
+SharedStateReader::~SharedStateReader()
+{
+    munmap(const_cast<SharedStateHeader*>(header_), size_);
+}
+
+SharedStateSample SharedStateReader::create_sample() const
+{
+    SharedStateSample sample;
+    sample.sequence = 0;
+    sample.timestamp = 0.;
+    sample.values.resize(header_->joint_count);
+    sample.covariance_diagonal.resize(header_->joint_count);
+    return sample;
+}
+
+bool SharedStateReader::read_latest(SharedStateSample& sample) const
+{
+    // the latest slot may be overwritten while reading if the writer laps
+    // the reader. Retry with the then latest estimate.
+    while (true)
+    {
+        const std::uint64_t count = write_count();
+        if (count == 0) return false;
+        if (read(count - 1, sample)) return true;
+    }
+}
+
+bool SharedStateReader::read(std::uint64_t sequence,
+                             SharedStateSample& sample) const
+{
+    const std::uint64_t count = write_count();
+    if (sequence >= count || count - sequence > header_->capacity)
+    {
+        return false;
+    }
+
+    const std::size_t joint_count = header_->joint_count;
+    const std::size_t bytes = joint_count * sizeof(double);
+    if (sample.values.size() != joint_count) sample.values.resize(joint_count);
+    if (sample.covariance_diagonal.size() != joint_count)
+    {
+        sample.covariance_diagonal.resize(joint_count);
+    }
+
+    const SlotHeader* slot = slot_at(header_, sequence);
+    const double* data = reinterpret_cast<const double*>(slot + 1);
+
+    std::uint64_t slot_sequence;
+    while (true)
+    {
+        const std::uint64_t lock = slot->lock.load(std::memory_order_acquire);
+        if (lock & 1) continue;
+
+        slot_sequence = slot->sequence;
+        sample.timestamp = slot->timestamp;
+        std::memcpy(sample.values.data(), data, bytes);
+        std::memcpy(
+            sample.covariance_diagonal.data(), data + joint_count, bytes);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->lock.load(std::memory_order_relaxed) == lock) break;
+    }
+
+    sample.sequence = slot_sequence;
+    return slot_sequence == sequence;
+}
+
+std::uint64_t SharedStateReader::write_count() const
+{
+    return header_->write_count.load(std::memory_order_acquire);
+}
+
+int SharedStateReader::joint_count() const
+{
+    return header_->joint_count;
+}
+
+int SharedStateReader::capacity() const
+{
+    return header_->capacity;
+}
+}
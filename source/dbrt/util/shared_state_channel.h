@@ -0,0 +1,150 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file shared_state_channel.h
+ * \date October 2026
+ *
+ * Shared memory ring of state estimates for co-located processes. A single
+ * writer publishes each estimate into the next slot of the ring. Every slot
+ * is guarded by a sequence lock, i.e. readers never block the writer and
+ * retry if the slot has been modified while reading.
+ *
+ * This header and its implementation only depend on the standard library
+ * and POSIX and can be linked by readers through the dbrt_shared_state
+ * library.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief Header at the beginning of the shared memory segment
+ */
+struct alignas(64) SharedStateHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t joint_count;
+    std::uint32_t capacity;
+    std::uint64_t slot_size;
+    // number of estimates written so far. The latest one is in slot
+    // (write_count - 1) % capacity.
+    std::atomic<std::uint64_t> write_count;
+};
+
+/**
+ * \brief Estimate as copied out of the channel
+ */
+struct SharedStateSample
+{
+    // consecutive number of the estimate, starting at 0
+    std::uint64_t sequence;
+    // time stamp of the estimate in seconds
+    double timestamp;
+    // joint values and joint variances in model order
+    std::vector<double> values;
+    std::vector<double> covariance_diagonal;
+};
+
+/**
+ * \brief Creates the shared memory segment and writes estimates into it.
+ *     The segment is removed on destruction.
+ */
+class SharedStateWriter
+{
+public:
+    /**
+     * \param name
+     *     POSIX shared memory name, e.g. /dbrt_estimated_state
+     * \param joint_count
+     *     Number of joints of each estimate
+     * \param capacity
+     *     Number of estimates kept in the ring
+     */
+    SharedStateWriter(const std::string& name,
+                      int joint_count,
+                      int capacity);
+    ~SharedStateWriter();
+
+    SharedStateWriter(const SharedStateWriter&) = delete;
+    SharedStateWriter& operator=(const SharedStateWriter&) = delete;
+
+    /**
+     * \brief Publishes an estimate. Both arrays must contain joint_count
+     *     values. Wait-free and does not allocate.
+     */
+    void write(double timestamp,
+               const double* values,
+               const double* covariance_diagonal);
+
+    int joint_count() const;
+
+private:
+    std::string name_;
+    std::size_t size_;
+    SharedStateHeader* header_;
+};
+
+/**
+ * \brief Opens an existing shared memory segment created by a
+ *     SharedStateWriter for reading
+ */
+class SharedStateReader
+{
+public:
+    explicit SharedStateReader(const std::string& name);
+    ~SharedStateReader();
+
+    SharedStateReader(const SharedStateReader&) = delete;
+    SharedStateReader& operator=(const SharedStateReader&) = delete;
+
+    /**
+     * \brief Returns a sample with buffers sized for this channel. Reading
+     *     into it does not allocate.
+     */
+    SharedStateSample create_sample() const;
+
+    /**
+     * \brief Copies the latest estimate into the sample. Returns false if
+     *     nothing has been written yet.
+     */
+    bool read_latest(SharedStateSample& sample) const;
+
+    /**
+     * \brief Copies the estimate with the given sequence number into the
+     *     sample. Returns false if it has not been written yet or has
+     *     already been overwritten.
+     */
+    bool read(std::uint64_t sequence, SharedStateSample& sample) const;
+
+    /**
+     * \brief Number of estimates written so far
+     */
+    std::uint64_t write_count() const;
+
+    int joint_count() const;
+    int capacity() const;
+
+private:
+    std::size_t size_;
+    const SharedStateHeader* header_;
+};
+}
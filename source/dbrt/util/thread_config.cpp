@@ -0,0 +1,150 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file thread_config.cpp
+ * \date October 2026
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <dbrt/util/thread_config.h>
+#include <pthread.h>
+#include <ros/ros.h>
+#include <sched.h>
+#include <sstream>
+#include <sys/mman.h>
+
+namespace dbrt
+{
+namespace
+{
+std::string cpu_list(const std::vector<int>& cpus)
+{
+    std::ostringstream list;
+    for (size_t i = 0; i < cpus.size(); ++i)
+    {
+        list << (i > 0 ? "," : "") << cpus[i];
+    }
+    return list.str();
+}
+}
+
+bool apply_thread_config(const std::string& name, const ThreadConfig& config)
+{
+    bool success = true;
+    pthread_t thread = pthread_self();
+
+    // thread names are limited to 15 characters
+    pthread_setname_np(thread, name.substr(0, 15).c_str());
+
+    if (!config.cpus.empty())
+    {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (int cpu : config.cpus)
+        {
+            CPU_SET(cpu, &cpu_set);
+        }
+
+        int error = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+        if (error != 0)
+        {
+            ROS_WARN("Cannot pin thread %s to cpus %s: %s",
+                     name.c_str(),
+                     cpu_list(config.cpus).c_str(),
+                     std::strerror(error));
+            success = false;
+        }
+    }
+
+    if (config.priority > 0)
+    {
+        sched_param parameters;
+        parameters.sched_priority = config.priority;
+
+        int error = pthread_setschedparam(thread, SCHED_FIFO, &parameters);
+        if (error != 0)
+        {
+            ROS_WARN(
+                "Cannot set SCHED_FIFO priority %d for thread %s: %s. "
+                "Real-time scheduling requires CAP_SYS_NICE or an rtprio "
+                "limit.",
+                config.priority,
+                name.c_str(),
+                std::strerror(error));
+            success = false;
+        }
+    }
+
+    ROS_INFO("Thread %s: %s", name.c_str(), describe_current_thread().c_str());
+
+    return success;
+}
+
+bool lock_process_memory()
+{
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        ROS_WARN("Cannot lock process memory: %s", std::strerror(errno));
+        return false;
+    }
+
+    ROS_INFO("Process memory locked");
+    return true;
+}
+
+std::string describe_current_thread()
+{
+    pthread_t thread = pthread_self();
+    std::ostringstream description;
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (pthread_getaffinity_np(thread, sizeof(cpu_set), &cpu_set) == 0)
+    {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &cpu_set)) cpus.push_back(cpu);
+        }
+        description << "cpus " << cpu_list(cpus);
+    }
+    else
+    {
+        description << "cpus unknown";
+    }
+
+    int policy;
+    sched_param parameters;
+    if (pthread_getschedparam(thread, &policy, &parameters) == 0)
+    {
+        switch (policy)
+        {
+            case SCHED_FIFO:
+                description << ", SCHED_FIFO priority "
+                            << parameters.sched_priority;
+                break;
+            case SCHED_RR:
+                description << ", SCHED_RR priority "
+                            << parameters.sched_priority;
+                break;
+            default:
+                description << ", default scheduling";
+                break;
+        }
+    }
+
+    return description.str();
+}
+}
@@ -0,0 +1,62 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file thread_config.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace dbrt
+{
+/**
+ * \brief CPU affinity and scheduling of a tracker thread
+ */
+struct ThreadConfig
+{
+    ThreadConfig() : priority(0) {}
+
+    // CPUs the thread may run on. Empty allows all CPUs.
+    std::vector<int> cpus;
+    // SCHED_FIFO priority in [1, 99]. 0 keeps the default scheduling.
+    int priority;
+};
+
+/**
+ * \brief Names the calling thread and applies the given configuration to
+ *     it. Failures, e.g. due to missing real-time permissions, are reported
+ *     and leave the respective setting unchanged. The effective
+ *     configuration is reported in either case.
+ *
+ * \return true if all settings have been applied
+ */
+bool apply_thread_config(const std::string& name, const ThreadConfig& config);
+
+/**
+ * \brief Locks all current and future pages of the process into memory to
+ *     avoid page faults on the tracking path
+ *
+ * \return true on success
+ */
+bool lock_process_memory();
+
+/**
+ * \brief Describes the effective CPU affinity and scheduling of the calling
+ *     thread
+ */
+std::string describe_current_thread();
+}
@@ -0,0 +1,41 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file thread_config_factory.cpp
+ * \date October 2026
+ */
+
+#include <dbrt/util/thread_config_factory.h>
+
+namespace dbrt
+{
+ThreadConfig create_thread_config(ros::NodeHandle& nh,
+                                  const std::string& prefix,
+                                  const std::string& name)
+{
+    ThreadConfig config;
+    nh.param<std::vector<int>>(
+        prefix + "threads/" + name + "/cpus", config.cpus, std::vector<int>());
+    config.priority =
+        nh.param<int>(prefix + "threads/" + name + "/priority", 0);
+
+    if (config.priority < 0 || config.priority > 99)
+    {
+        ROS_ERROR("Priority of thread %s must be in [0, 99]", name.c_str());
+        exit(-1);
+    }
+
+    return config;
+}
+}
@@ -0,0 +1,35 @@
+/*
+ * This is part of the Bayesian Object Tracking (bot),
+ * (https://github.com/bayesian-object-tracking)
+ *
+ * Copyright (c) 2015 Max Planck Society,
+ * 				 Autonomous Motion Department,
+ * 			     Institute for Intelligent Systems
+ *
+ * This Source Code Form is subject to the terms of the GNU General Public
+ * License License (GNU GPL). A copy of the license can be found in the LICENSE
+ * file distributed with this source code.
+ */
+
+/**
+ * \file thread_config_factory.h
+ * \date October 2026
+ */
+
+#pragma once
+
+#include <dbrt/util/thread_config.h>
+#include <ros/ros.h>
+#include <string>
+
+namespace dbrt
+{
+/**
+ * \brief Reads the configuration of the named thread from the parameters
+ *     threads/<name>/cpus (list of CPU indices) and threads/<name>/priority.
+ *     Missing parameters keep the default affinity and scheduling.
+ */
+ThreadConfig create_thread_config(ros::NodeHandle& nh,
+                                  const std::string& prefix,
+                                  const std::string& name);
+}